@@ -1,6 +1,6 @@
 #include "CgiHandler.hpp"
 
-CgiHandler::CgiHandler()
+CgiHandler::CgiHandler() : messageBody(nullptr)
 {
 }
 
@@ -9,12 +9,7 @@ CgiHandler::CgiHandler(const Request &request, std::unordered_map<std::string, s
 	config = request.getConfig();
 	scriptName = cgiParams["fileName"];
 	cgiOutput = "";
-	messageBody = request.getBody();
-	messageBodyStr.reserve(messageBody.size());
-	for (const auto &byte : messageBody)
-	{
-		messageBodyStr.push_back(static_cast<char>(byte));
-	}
+	messageBody = &request.getBody();
 }
 
 CgiHandler::~CgiHandler()
@@ -61,11 +56,9 @@ void CgiHandler::setupCgiEnv(const Request &request, const ConfigData &server, s
 {
 	envMap["REQUEST_METHOD"] = request.getMethodStr();
 	envMap["CONTENT_TYPE"] = request.getContentType();
-	envMap["CONTENT_LENGTH"] = std::to_string(request.getContentLength());
+	envMap["CONTENT_LENGTH"] = std::to_string(request.getBodySize()); // the decoded size of a chunked body too
 	envMap["QUERY_STRING"] = cgiParams["queryParams"];
-	std::cout << "scriptName: " << scriptName << std::endl;
 	envMap["PATH_INFO"] = scriptName;
-	std::cout << "cgiBinDir: " << cgiBinDir << std::endl;
 	envMap["PATH_TRANSLATED"] = StringUtils::joinPath(cgiBinDir, scriptName);
 	envMap["SERVER_PORT"] = server.getServerPortString();
 	envMap["SERVER_NAME"] = server.getServerName();
@@ -85,12 +78,16 @@ void CgiHandler::printEnv()
 
 /* Create a new process to execute the CGI script:
 - open cgi pipe
+- give the script its stdin: a spooled body as is, a small one written to the pipe
 - fork and execute in the child process
 - wait for the child process to finish
 - close the pipe
 */
 void CgiHandler::createCgiProcess()
 {
+	const RequestBody *stdinBody = spoolLargeBody();
+	if (stdinBody == nullptr)
+		return;
 	if (pipe(dataToCgiPipe) == -1 || pipe(dataFromCgiPipe) == -1)
 	{
 		closeCgiPipes();
@@ -98,6 +95,9 @@ void CgiHandler::createCgiProcess()
 		Logger::log(ERROR, ERROR_MESSAGE, "Error: pipe() failed\n");
 		return;
 	}
+	// at most PIPE_BUF bytes into the empty pipe, which never blocks
+	if (!stdinBody->isSpooled() && !stdinBody->empty())
+		write(dataToCgiPipe[WRITE_END], stdinBody->data(), stdinBody->getSize());
 	pid_t pid = fork();
 	if (pid == -1)
 	{
@@ -108,13 +108,9 @@ void CgiHandler::createCgiProcess()
 	}
 	if (pid == 0) // child process
 	{
-		// redirect stdin and stdout
-		dup2(dataToCgiPipe[READ_END], STDIN_FILENO);
+		// redirect stdin and stdout, a spooled body is read by the script straight from its temp file
+		dup2(stdinBody->isSpooled() ? stdinBody->getSpoolFd() : dataToCgiPipe[READ_END], STDIN_FILENO);
 		dup2(dataFromCgiPipe[WRITE_END], STDOUT_FILENO);
-
-		// write message body to cgi process's stdin
-		write(dataToCgiPipe[WRITE_END], messageBodyStr.c_str(), messageBodyStr.size());
-
 		closeCgiPipes();
 
 		executeCgiScript();
@@ -130,6 +126,27 @@ void CgiHandler::createCgiProcess()
 	}
 }
 
+/* The body the script reads as its stdin. One in memory that does not fit in the pipe is spooled
+ * to a temp file first, the script only starts reading after the whole body has been handed over.
+ */
+const RequestBody *CgiHandler::spoolLargeBody()
+{
+	if (messageBody == nullptr || messageBody->isSpooled() || messageBody->getSize() <= PIPE_BUF)
+		return (messageBody == nullptr ? &stdinSpool : messageBody);
+	try
+	{
+		stdinSpool = RequestBody(0);
+		stdinSpool.append(messageBody->data(), messageBody->getSize());
+	}
+	catch (const RequestBody::SpoolException &e)
+	{
+		cgiExitStatus = HttpStatusCode::INTERNAL_SERVER_ERROR;
+		Logger::log(ERROR, ERROR_MESSAGE, "Error: %s\n", e.what());
+		return (nullptr);
+	}
+	return (&stdinSpool);
+}
+
 void CgiHandler::cgiTimeout(pid_t pid)
 {
 	int status;
@@ -1,10 +1,12 @@
 #pragma once
 
 #include <unistd.h>
+#include <climits>
 #include <string>
 #include <iostream>
 #include <map>
 #include <signal.h>
+#include <sys/wait.h>
 
 #include "../Request/Request.hpp"
 #include "../Config/ConfigParser.hpp"
@@ -44,6 +46,7 @@ private:
 	void readCgiOutput();
 	void executeCgiScript();
 	void cgiTimeout(pid_t pid);
+	const RequestBody *spoolLargeBody();
 
 	std::map<std::string, std::string> envMap;
 	std::string scriptName;
@@ -52,8 +55,8 @@ private:
 	int dataToCgiPipe[2] = {-1, -1};
 	int dataFromCgiPipe[2] = {-1, -1};
 	std::string cgiOutput;
-	std::vector<std::byte> messageBody;
-	std::string messageBodyStr;
+	const RequestBody *messageBody; // owned by the request, which outlives the handler
+	RequestBody stdinSpool;			// a body too large for the stdin pipe, spooled for the script
 	HttpStatusCode cgiExitStatus;
 	ConfigData config;
 };
\ No newline at end of file
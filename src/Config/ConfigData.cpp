@@ -1,8 +1,12 @@
 #include "ConfigData.hpp"
 
-ConfigData::ConfigData() {}
+ConfigData::ConfigData()
+	: maxConnections(DefaultValues::MAX_CONNECTIONS), streamWindowSize(DefaultValues::STREAM_WINDOW_SIZE),
+	  maxHeaderSize(DefaultValues::CLIENT_MAX_HEADER_SIZE), bodyBufferSize(DefaultValues::CLIENT_BODY_BUFFER_SIZE) {}
 
 ConfigData::ConfigData(std::string &input)
+	: maxConnections(DefaultValues::MAX_CONNECTIONS), streamWindowSize(DefaultValues::STREAM_WINDOW_SIZE),
+	  maxHeaderSize(DefaultValues::CLIENT_MAX_HEADER_SIZE), bodyBufferSize(DefaultValues::CLIENT_BODY_BUFFER_SIZE)
 {
 	serverBlock = input;
 	analyzeConfigData();
@@ -30,6 +34,11 @@ ConfigData &ConfigData::operator=(const ConfigData &other)
 		cgiExtension = other.cgiExtension;
 		cgiExecutor = other.cgiExecutor;
 		cgiExtenExecutorMap = other.cgiExtenExecutorMap;
+		timeoutsMs = other.timeoutsMs;
+		maxConnections = other.maxConnections;
+		streamWindowSize = other.streamWindowSize;
+		maxHeaderSize = other.maxHeaderSize;
+		bodyBufferSize = other.bodyBufferSize;
 	}
 	return *this;
 }
@@ -46,6 +55,14 @@ void ConfigData::analyzeConfigData()
 	extractLocationBlocks();
 	extractCgiDir();
 	extractcgiExtenExecutorMap();
+	extractTimeouts();
+	extractMaxConnections();
+	streamWindowSize = parseSize(DirectiveKeys::STREAM_WINDOW_SIZE, DefaultValues::STREAM_WINDOW_SIZE,
+								 MIN_STREAM_WINDOW_SIZE, MAX_STREAM_WINDOW_SIZE);
+	maxHeaderSize = parseSize(DirectiveKeys::CLIENT_MAX_HEADER_SIZE, DefaultValues::CLIENT_MAX_HEADER_SIZE,
+							  MIN_CLIENT_HEADER_SIZE, MAX_CLIENT_HEADER_SIZE);
+	bodyBufferSize = parseSize(DirectiveKeys::CLIENT_BODY_BUFFER_SIZE, DefaultValues::CLIENT_BODY_BUFFER_SIZE,
+							   MIN_CLIENT_BODY_BUFFER_SIZE, MAX_CLIENT_BODY_BUFFER_SIZE);
 }
 
 // Generic print function
@@ -377,15 +394,21 @@ void ConfigData::extractCgiExecutor()
 
 /* In nginx, setting size to 0 means no limit on client body size.
 But we don't allow that. 0 is invalid.
+A location can set its own client_max_body_size, so only the lines outside the location blocks count here.
 */
 void ConfigData::extractMaxClientBodySize()
 {
-	std::string maxClientBodySizeStr = extractDirectiveValue(serverBlock, DirectiveKeys::ClientBodySize);
+	std::string maxClientBodySizeStr = extractDirectiveValue(getServerLevelBlock(), DirectiveKeys::ClientBodySize);
 	if (maxClientBodySizeStr.empty())
 	{
 		maxClientBodySize = DefaultValues::MAX_CLIENT_BODY_SIZE;
 		return;
 	}
+	maxClientBodySize = bodySizeToBytes(maxClientBodySizeStr);
+}
+
+size_t ConfigData::bodySizeToBytes(const std::string &maxClientBodySizeStr)
+{
 	std::unordered_map<std::string, int> units = {
 		{"k", 1024},
 		{"K", 1024},
@@ -418,7 +441,7 @@ void ConfigData::extractMaxClientBodySize()
 		{
 			throw std::runtime_error("Out of range max client body size: " + maxClientBodySizeStr);
 		}
-		this->maxClientBodySize = numberPartSizeT * multiplier;
+		return numberPartSizeT * multiplier;
 	}
 	else
 	{
@@ -426,6 +449,93 @@ void ConfigData::extractMaxClientBodySize()
 	}
 }
 
+void ConfigData::extractTimeouts()
+{
+	timeoutsMs[CLIENT_HEADER_TIMEOUT] = parseTimeout(DirectiveKeys::CLIENT_HEADER_TIMEOUT);
+	timeoutsMs[CLIENT_BODY_TIMEOUT] = parseTimeout(DirectiveKeys::CLIENT_BODY_TIMEOUT);
+	timeoutsMs[KEEPALIVE_TIMEOUT] = parseTimeout(DirectiveKeys::KEEPALIVE_TIMEOUT);
+	timeoutsMs[SEND_TIMEOUT] = parseTimeout(DirectiveKeys::SEND_TIMEOUT);
+}
+
+/* Timeouts are given like in nginx: a number with an optional unit ms, s (default) or m.
+Handling error:
+- Invalid format or unit
+- 0 or more than a day
+*/
+size_t ConfigData::parseTimeout(const std::string &directiveKey)
+{
+	std::string timeoutStr = extractDirectiveValue(serverBlock, directiveKey);
+	if (timeoutStr.empty())
+		return DefaultValues::TIMEOUT_MS;
+	return timeoutToMs(directiveKey, timeoutStr);
+}
+
+// shared with the global directives that take a time
+size_t ConfigData::timeoutToMs(const std::string &directiveKey, const std::string &timeoutStr)
+{
+	std::regex pattern("(\\d{1,8})(ms|s|m)?");
+	std::smatch matches;
+	if (!std::regex_match(timeoutStr, matches, pattern))
+		throw std::runtime_error("Invalid " + directiveKey + ": " + timeoutStr);
+	size_t value = StringUtils::strToSizeT(matches[1].str());
+	std::string unit = matches[2].str();
+	if (unit.empty() || unit == "s")
+		value *= 1000;
+	else if (unit == "m")
+		value *= 60 * 1000;
+	if (value == 0 || value > MAX_TIMEOUT_MS)
+		throw std::runtime_error("Out of range " + directiveKey + ": " + timeoutStr);
+	return value;
+}
+
+/* Connections the listening socket of this server block admits at once, 0 (default) for no limit.
+Handling error:
+- Not a number
+- More than MAX_CONNECTIONS_LIMIT
+*/
+void ConfigData::extractMaxConnections()
+{
+	std::string maxConnectionsStr = extractDirectiveValue(serverBlock, DirectiveKeys::MAX_CONNECTIONS);
+	if (maxConnectionsStr.empty())
+		return;
+	if (!StringUtils::isDigitsOnly(maxConnectionsStr) || maxConnectionsStr.size() > 7)
+		throw std::runtime_error("Invalid max connections: " + maxConnectionsStr);
+	maxConnections = StringUtils::strToSizeT(maxConnectionsStr);
+	if (maxConnections > MAX_CONNECTIONS_LIMIT)
+		throw std::runtime_error("Max connections out of range: " + maxConnectionsStr);
+}
+
+/* Sizes are given like in nginx: a number of bytes with an optional unit k or m.
+Handling error:
+- Invalid format or unit
+- Out of the given range
+*/
+size_t ConfigData::parseSize(const std::string &directiveKey, size_t const &defaultValue, size_t const &minValue, size_t const &maxValue)
+{
+	std::string sizeStr = extractDirectiveValue(serverBlock, directiveKey);
+	if (sizeStr.empty())
+		return defaultValue;
+	return sizeToBytes(directiveKey, sizeStr, minValue, maxValue);
+}
+
+// shared with the global directives that take a size
+size_t ConfigData::sizeToBytes(const std::string &directiveKey, const std::string &sizeStr, size_t const &minValue, size_t const &maxValue)
+{
+	std::regex pattern("(\\d{1,9})([kKmM]?)");
+	std::smatch matches;
+	if (!std::regex_match(sizeStr, matches, pattern))
+		throw std::runtime_error("Invalid " + directiveKey + ": " + sizeStr);
+	size_t value = StringUtils::strToSizeT(matches[1].str());
+	std::string unit = matches[2].str();
+	if (unit == "k" || unit == "K")
+		value *= 1024;
+	else if (unit == "m" || unit == "M")
+		value *= 1024 * 1024;
+	if (value < minValue || value > maxValue)
+		throw std::runtime_error("Out of range " + directiveKey + ": " + sizeStr);
+	return value;
+}
+
 /* Extract location blocks from server block and create Location objects for each location block. If a location block has a route that already exists in the locations map, skip it.
  */
 void ConfigData::extractLocationBlocks()
@@ -435,12 +545,40 @@ void ConfigData::extractLocationBlocks()
 	{
 		Location location(locationBlock);
 		location.analyzeLocationData();
+		std::string locationBodySize = extractDirectiveValue(locationBlock, DirectiveKeys::ClientBodySize);
+		location.setMaxBodySize(locationBodySize.empty() ? maxClientBodySize : bodySizeToBytes(locationBodySize));
 		std::string route = location.getLocationRoute();
 		if (locations.find(route) == locations.end())
 			locations[location.getLocationRoute()] = location;
 	}
 }
 
+// the lines of the server block outside its location blocks
+std::string ConfigData::getServerLevelBlock() const
+{
+	std::istringstream iss(serverBlock);
+	std::string line;
+	std::string serverLevelBlock;
+	int braceCount = 0;
+	bool insideBlock = false;
+
+	while (std::getline(iss, line))
+	{
+		if (line.find("location") != std::string::npos && line.find(" {") != std::string::npos)
+			insideBlock = true;
+		if (!insideBlock)
+		{
+			serverLevelBlock += line + "\n";
+			continue;
+		}
+		if (line.find("{") != std::string::npos)
+			braceCount++;
+		if (line.find("}") != std::string::npos && --braceCount == 0)
+			insideBlock = false;
+	}
+	return serverLevelBlock;
+}
+
 void ConfigData::splitLocationBlocks()
 {
 	std::istringstream iss(serverBlock);
@@ -533,6 +671,14 @@ Location ConfigData::getMatchingLocation(std::string locationRoute) const
 	}
 }
 
+size_t ConfigData::getTimeoutMs(ClientTimeout const &timeout) const
+{
+	std::unordered_map<int, size_t>::const_iterator it = timeoutsMs.find(timeout);
+	if (it == timeoutsMs.end())
+		return DefaultValues::TIMEOUT_MS;
+	return it->second;
+}
+
 std::string ConfigData::getCgiDir() const
 {
 	return cgiDir;
@@ -551,4 +697,24 @@ std::vector<std::string> ConfigData::getCgiExecutor() const
 std::unordered_map<std::string, std::string> ConfigData::getCgiExtenExecutorMap() const
 {
 	return cgiExtenExecutorMap;
-}
\ No newline at end of file
+}
+
+size_t ConfigData::getMaxConnections() const
+{
+	return maxConnections;
+}
+
+size_t ConfigData::getStreamWindowSize() const
+{
+	return streamWindowSize;
+}
+
+size_t ConfigData::getMaxHeaderSize() const
+{
+	return maxHeaderSize;
+}
+
+size_t ConfigData::getBodyBufferSize() const
+{
+	return bodyBufferSize;
+}
@@ -23,6 +23,18 @@
 #define MAX_SERVER_NAME_LENGTH 253
 #define MIN_ERROR_CODE 400
 #define MAX_ERROR_CODE 599
+#define MAX_WORKER_THREADS 64
+#define MAX_ACCEPT_BUDGET 4096
+#define MAX_CONNECTIONS_LIMIT 1000000
+#define MIN_STREAM_WINDOW_SIZE 4096
+#define MAX_STREAM_WINDOW_SIZE 16777216
+#define MIN_CLIENT_HEADER_SIZE 1024
+#define MAX_CLIENT_HEADER_SIZE 1048576
+#define MIN_CLIENT_BODY_BUFFER_SIZE 1024
+#define MAX_CLIENT_BODY_BUFFER_SIZE 1073741824
+#define MAX_TIMEOUT_MS 86400000
+#define MAX_OPEN_FILE_CACHE 65536
+#define MAX_CONTENT_CACHE_SIZE 1073741824
 
 namespace DirectiveKeys
 {
@@ -34,6 +46,23 @@ namespace DirectiveKeys
 	const std::string CGI_DIR = "cgi_dir";
 	const std::string CGI_EXTENSION = "cgi_exten";
 	const std::string CGI_EXECUTOR = "cgi_executor";
+	const std::string CLIENT_HEADER_TIMEOUT = "client_header_timeout";
+	const std::string CLIENT_BODY_TIMEOUT = "client_body_timeout";
+	const std::string KEEPALIVE_TIMEOUT = "keepalive_timeout";
+	const std::string SEND_TIMEOUT = "send_timeout";
+	const std::string MAX_CONNECTIONS = "max_connections"; // also a global directive
+	const std::string STREAM_WINDOW_SIZE = "stream_window_size";
+	const std::string CLIENT_MAX_HEADER_SIZE = "client_max_header_size";
+	const std::string CLIENT_BODY_BUFFER_SIZE = "client_body_buffer_size";
+	// Global directives, outside of server blocks
+	const std::string EVENT_ENGINE = "event_engine";
+	const std::string WORKER_THREADS = "worker_threads";
+	const std::string ACCEPT_BUDGET = "accept_budget";
+	const std::string OPEN_FILE_CACHE = "open_file_cache";
+	const std::string OPEN_FILE_CACHE_VALID = "open_file_cache_valid";
+	const std::string OPEN_FILE_CACHE_ERRORS = "open_file_cache_errors";
+	const std::string CONTENT_CACHE_SIZE = "content_cache_size";
+	const std::string CONTENT_CACHE_MAX_FILE_SIZE = "content_cache_max_file_size";
 	// Add more directive keys here
 }
 
@@ -44,6 +73,23 @@ namespace DefaultValues
 	const std::string SERVER_NAME = "localhost";
 	const long long MAX_CLIENT_BODY_SIZE = 1048576;
 	const std::string CGI_DIR = "./cgi-bin";
+	const size_t TIMEOUT_MS = SERVER_TIMEOUT;
+	const int WORKER_THREADS = 1;
+	const int ACCEPT_BUDGET = 64;
+	const size_t MAX_CONNECTIONS = 0; // unlimited
+	const size_t STREAM_WINDOW_SIZE = DEFAULT_STREAM_WINDOW_SIZE;
+	const size_t CLIENT_MAX_HEADER_SIZE = DEFAULT_CLIENT_MAX_HEADER_SIZE;
+	const size_t CLIENT_BODY_BUFFER_SIZE = DEFAULT_CLIENT_BODY_BUFFER_SIZE;
+	const size_t OPEN_FILE_CACHE = 0; // disabled
+	const size_t OPEN_FILE_CACHE_VALID_MS = 60000;
+	const bool OPEN_FILE_CACHE_ERRORS = false;
+	const size_t CONTENT_CACHE_SIZE = 0; // disabled
+	const size_t CONTENT_CACHE_MAX_FILE_SIZE = 1048576;
+#ifdef __linux__
+	const EventEngine EVENT_ENGINE = EventEngine::ENGINE_EPOLL;
+#else
+	const EventEngine EVENT_ENGINE = EventEngine::ENGINE_POLL;
+#endif
 }
 
 class ConfigData
@@ -70,6 +116,15 @@ public:
 	std::vector<std::string> getCgiExecutor() const;
 	std::unordered_map<std::string, std::string> getCgiExtenExecutorMap() const;
 	Location getMatchingLocation(std::string locationRoute) const;
+	size_t getTimeoutMs(ClientTimeout const &timeout) const;
+	size_t getMaxConnections() const;
+	size_t getStreamWindowSize() const;
+	size_t getMaxHeaderSize() const;
+	size_t getBodyBufferSize() const;
+
+	static size_t timeoutToMs(const std::string &directiveKey, const std::string &timeoutStr);
+	static size_t bodySizeToBytes(const std::string &maxClientBodySizeStr);
+	static size_t sizeToBytes(const std::string &directiveKey, const std::string &sizeStr, size_t const &minValue, size_t const &maxValue);
 
 private:
 	std::string serverBlock;
@@ -86,6 +141,11 @@ private:
 	std::vector<std::string> cgiExtension;
 	std::vector<std::string> cgiExecutor;
 	std::unordered_map<std::string, std::string> cgiExtenExecutorMap;
+	std::unordered_map<int, size_t> timeoutsMs; // keyed by ClientTimeout
+	size_t maxConnections;
+	size_t streamWindowSize;
+	size_t maxHeaderSize;
+	size_t bodyBufferSize; // request bodies above it are spooled to a temporary file
 
 	std::string extractDirectiveValue(const std::string &confBlock, const std::string &directiveKey);
 	void extractMultipleArgValues(const std::string &directiveKey, std::vector<std::string> &values);
@@ -102,5 +162,10 @@ private:
 	void extractCgiExecutor();
 	void extractcgiExtenExecutorMap();
 	void splitLocationBlocks();
+	std::string getServerLevelBlock() const;
 	void validateCgiExtension(std::string &extension);
+	void extractTimeouts();
+	void extractMaxConnections();
+	size_t parseSize(const std::string &directiveKey, size_t const &defaultValue, size_t const &minValue, size_t const &maxValue);
+	size_t parseTimeout(const std::string &directiveKey);
 };
\ No newline at end of file
@@ -42,6 +42,8 @@ void ConfigParser::extractServerConfigs()
     }
     // checkForDuplicateHostAndPort();
     checkForDuplicateNameAndPort();
+    checkListenerMaxConnections();
+    globalConfig = GlobalConfig(globalBlock);
 }
 
 void ConfigParser::checkForDuplicateNameAndPort()
@@ -70,6 +72,23 @@ void ConfigParser::checkForDuplicateHostAndPort()
     }
 }
 
+// max_connections limits a listening address, the server blocks sharing one may not set different limits
+void ConfigParser::checkListenerMaxConnections()
+{
+    std::unordered_map<std::string, size_t> limits;
+    for (const auto &server : servers)
+    {
+        if (server.getMaxConnections() == 0)
+            continue;
+        std::string key = server.getServerHost() + ":" + std::to_string(server.getServerPort());
+        std::pair<std::unordered_map<std::string, size_t>::iterator, bool> inserted = limits.insert({key, server.getMaxConnections()});
+        if (!inserted.second && inserted.first->second != server.getMaxConnections())
+        {
+            throw std::runtime_error("Conflicting max_connections for listen address: " + key);
+        }
+    }
+}
+
 // void checkDuplicateConfig(std::string config1, std::string config2)
 // {
 //     if (config1 == config2)
@@ -88,6 +107,7 @@ void ConfigParser::checkForDuplicateHostAndPort()
 void ConfigParser::printCluster()
 {
     int i = 0;
+    globalConfig.printGlobalConfig();
     for (auto &server : servers)
     {
         std::cout << "Server " << i++ << ":\n";
@@ -101,6 +121,11 @@ std::vector<ConfigData> ConfigParser::getServerConfigs()
     return servers;
 }
 
+GlobalConfig ConfigParser::getGlobalConfig()
+{
+    return globalConfig;
+}
+
 std::string ConfigParser::removeComments(std::string &fullFileContent)
 {
     std::regex commentRegex("#.*"); // Matches any line starting with '#'
@@ -137,6 +162,8 @@ void ConfigParser::splitServerBlocks()
                 }
             }
         }
+        else
+            globalBlock += line + "\n";
     }
     // for (auto &block : configBlock)
     // {
@@ -10,8 +10,10 @@
 #include <string>
 #include <regex>
 #include <unordered_set>
+#include <unordered_map>
 
 #include "ConfigData.hpp"
+#include "GlobalConfig.hpp"
 #include "../defines.hpp"
 
 class ConfigParser
@@ -24,15 +26,19 @@ public:
 	void extractServerConfigs();
 	void printCluster();
 	std::vector<ConfigData> getServerConfigs();
+	GlobalConfig getGlobalConfig();
 
 private:
 	std::string fileContent;
 	std::vector<std::string> configBlock;
 	std::vector<ConfigData> servers;
+	std::string globalBlock; // everything outside of server blocks
+	GlobalConfig globalConfig;
 	int serverCount; // number of servers
 
 	std::string removeComments(std::string &fullFileContent);
 	void splitServerBlocks();
 	void checkForDuplicateNameAndPort();
 	void checkForDuplicateHostAndPort();
+	void checkListenerMaxConnections();
 };
\ No newline at end of file
@@ -0,0 +1,251 @@
+#include "GlobalConfig.hpp"
+
+GlobalConfig::GlobalConfig()
+	: eventEngine(DefaultValues::EVENT_ENGINE), workerThreads(DefaultValues::WORKER_THREADS), acceptBudget(DefaultValues::ACCEPT_BUDGET), maxConnections(DefaultValues::MAX_CONNECTIONS),
+	  openFileCache(DefaultValues::OPEN_FILE_CACHE), openFileCacheValidMs(DefaultValues::OPEN_FILE_CACHE_VALID_MS), openFileCacheErrors(DefaultValues::OPEN_FILE_CACHE_ERRORS),
+	  contentCacheSize(DefaultValues::CONTENT_CACHE_SIZE), contentCacheMaxFileSize(DefaultValues::CONTENT_CACHE_MAX_FILE_SIZE) {}
+
+GlobalConfig::GlobalConfig(const std::string &input)
+	: globalBlock(input), eventEngine(DefaultValues::EVENT_ENGINE), workerThreads(DefaultValues::WORKER_THREADS), acceptBudget(DefaultValues::ACCEPT_BUDGET), maxConnections(DefaultValues::MAX_CONNECTIONS),
+	  openFileCache(DefaultValues::OPEN_FILE_CACHE), openFileCacheValidMs(DefaultValues::OPEN_FILE_CACHE_VALID_MS), openFileCacheErrors(DefaultValues::OPEN_FILE_CACHE_ERRORS),
+	  contentCacheSize(DefaultValues::CONTENT_CACHE_SIZE), contentCacheMaxFileSize(DefaultValues::CONTENT_CACHE_MAX_FILE_SIZE)
+{
+	analyzeGlobalConfig();
+}
+
+GlobalConfig::GlobalConfig(const GlobalConfig &other)
+{
+	*this = other;
+}
+
+GlobalConfig &GlobalConfig::operator=(const GlobalConfig &other)
+{
+	if (this != &other)
+	{
+		globalBlock = other.globalBlock;
+		eventEngine = other.eventEngine;
+		workerThreads = other.workerThreads;
+		acceptBudget = other.acceptBudget;
+		maxConnections = other.maxConnections;
+		openFileCache = other.openFileCache;
+		openFileCacheValidMs = other.openFileCacheValidMs;
+		openFileCacheErrors = other.openFileCacheErrors;
+		contentCacheSize = other.contentCacheSize;
+		contentCacheMaxFileSize = other.contentCacheMaxFileSize;
+	}
+	return *this;
+}
+
+GlobalConfig::~GlobalConfig() {}
+
+void GlobalConfig::analyzeGlobalConfig()
+{
+	extractEventEngine();
+	extractWorkerThreads();
+	extractAcceptBudget();
+	extractMaxConnections();
+	extractOpenFileCache();
+	extractContentCache();
+}
+
+void GlobalConfig::printGlobalConfig()
+{
+	std::cout << "Event engine: " << eventEngine << std::endl;
+	std::cout << "Worker threads: " << workerThreads << std::endl;
+	std::cout << "Accept budget: " << acceptBudget << std::endl;
+	std::cout << "Max connections: " << maxConnections << std::endl;
+	std::cout << "Open file cache: " << openFileCache << " valid " << openFileCacheValidMs << "ms errors " << openFileCacheErrors << std::endl;
+	std::cout << "Content cache: " << contentCacheSize << " bytes, files up to " << contentCacheMaxFileSize << std::endl;
+}
+
+std::string GlobalConfig::extractDirectiveValue(const std::string &directiveKey)
+{
+	std::istringstream stream(globalBlock);
+	std::string line;
+	int duplicate = 0;
+	std::string returnValue = "";
+	while (std::getline(stream, line))
+	{
+		std::regex directiveStartRegex("^\\s*" + directiveKey + "\\b"); // open_file_cache must not match open_file_cache_valid
+		if (std::regex_search(line, directiveStartRegex))
+		{
+			std::regex directiveRegex(directiveKey + "\\s+(\\S+)\\s*;");
+			std::smatch match;
+			if (std::regex_search(line, match, directiveRegex))
+			{
+				if (duplicate > 0)
+				{
+					throw std::runtime_error("Duplicate directive key: " + directiveKey);
+				}
+				returnValue = match[1].str();
+				duplicate++;
+			}
+			else
+				throw std::runtime_error("Invalid directive format: " + line);
+		}
+	}
+	return returnValue;
+}
+
+/* Handling error:
+- Unknown engine name
+- epoll requested on a platform that does not have it
+*/
+void GlobalConfig::extractEventEngine()
+{
+	std::string eventEngineStr = extractDirectiveValue(DirectiveKeys::EVENT_ENGINE);
+	if (eventEngineStr.empty())
+		return;
+	if (eventEngineStr == "poll")
+		eventEngine = EventEngine::ENGINE_POLL;
+	else if (eventEngineStr == "epoll")
+	{
+#ifdef __linux__
+		eventEngine = EventEngine::ENGINE_EPOLL;
+#else
+		throw std::runtime_error("Event engine not supported on this platform: " + eventEngineStr);
+#endif
+	}
+	else
+		throw std::runtime_error("Invalid event engine: " + eventEngineStr);
+}
+
+/* Handling error:
+- Not a number
+- Out of range: must be within 1-MAX_WORKER_THREADS
+*/
+void GlobalConfig::extractWorkerThreads()
+{
+	std::string workerThreadsStr = extractDirectiveValue(DirectiveKeys::WORKER_THREADS);
+	if (workerThreadsStr.empty())
+		return;
+	if (!StringUtils::isDigitsOnly(workerThreadsStr) || workerThreadsStr.size() > 3)
+		throw std::runtime_error("Invalid worker threads: " + workerThreadsStr);
+	workerThreads = std::stoi(workerThreadsStr);
+	if (workerThreads < 1 || workerThreads > MAX_WORKER_THREADS)
+		throw std::runtime_error("Worker threads out of range: " + workerThreadsStr);
+}
+
+/* How many connections a listener accepts per wakeup before the loop serves the other fds again.
+Handling error:
+- Not a number
+- Out of range: must be within 1-MAX_ACCEPT_BUDGET
+*/
+void GlobalConfig::extractAcceptBudget()
+{
+	std::string acceptBudgetStr = extractDirectiveValue(DirectiveKeys::ACCEPT_BUDGET);
+	if (acceptBudgetStr.empty())
+		return;
+	if (!StringUtils::isDigitsOnly(acceptBudgetStr) || acceptBudgetStr.size() > 5)
+		throw std::runtime_error("Invalid accept budget: " + acceptBudgetStr);
+	acceptBudget = std::stoi(acceptBudgetStr);
+	if (acceptBudget < 1 || acceptBudget > MAX_ACCEPT_BUDGET)
+		throw std::runtime_error("Accept budget out of range: " + acceptBudgetStr);
+}
+
+/* Connections the whole process admits at once, over all workers and servers, 0 (default) for no limit.
+Handling error:
+- Not a number
+- More than MAX_CONNECTIONS_LIMIT
+*/
+void GlobalConfig::extractMaxConnections()
+{
+	std::string maxConnectionsStr = extractDirectiveValue(DirectiveKeys::MAX_CONNECTIONS);
+	if (maxConnectionsStr.empty())
+		return;
+	if (!StringUtils::isDigitsOnly(maxConnectionsStr) || maxConnectionsStr.size() > 7)
+		throw std::runtime_error("Invalid max connections: " + maxConnectionsStr);
+	maxConnections = StringUtils::strToSizeT(maxConnectionsStr);
+	if (maxConnections > MAX_CONNECTIONS_LIMIT)
+		throw std::runtime_error("Max connections out of range: " + maxConnectionsStr);
+}
+
+/* Entries of the per-worker open file cache (0, the default, disables it), how long an entry is
+trusted before it is checked again, and whether failed lookups are cached too.
+Handling error:
+- Not a number, or more than MAX_OPEN_FILE_CACHE entries
+- Invalid time (see ConfigData::timeoutToMs)
+- Errors flag other than on or off
+*/
+void GlobalConfig::extractOpenFileCache()
+{
+	std::string openFileCacheStr = extractDirectiveValue(DirectiveKeys::OPEN_FILE_CACHE);
+	if (!openFileCacheStr.empty())
+	{
+		if (!StringUtils::isDigitsOnly(openFileCacheStr) || openFileCacheStr.size() > 5)
+			throw std::runtime_error("Invalid open file cache: " + openFileCacheStr);
+		openFileCache = StringUtils::strToSizeT(openFileCacheStr);
+		if (openFileCache > MAX_OPEN_FILE_CACHE)
+			throw std::runtime_error("Open file cache out of range: " + openFileCacheStr);
+	}
+	std::string validStr = extractDirectiveValue(DirectiveKeys::OPEN_FILE_CACHE_VALID);
+	if (!validStr.empty())
+		openFileCacheValidMs = ConfigData::timeoutToMs(DirectiveKeys::OPEN_FILE_CACHE_VALID, validStr);
+	std::string errorsStr = extractDirectiveValue(DirectiveKeys::OPEN_FILE_CACHE_ERRORS);
+	if (errorsStr == "on")
+		openFileCacheErrors = true;
+	else if (errorsStr == "off")
+		openFileCacheErrors = false;
+	else if (!errorsStr.empty())
+		throw std::runtime_error("Invalid open file cache errors: " + errorsStr);
+}
+
+/* Bytes of file content every worker keeps in memory (0, the default, disables it), and the largest
+file it takes, bigger ones are always sent from the file.
+Handling error:
+- Invalid size (see ConfigData::sizeToBytes), or more than MAX_CONTENT_CACHE_SIZE
+*/
+void GlobalConfig::extractContentCache()
+{
+	std::string sizeStr = extractDirectiveValue(DirectiveKeys::CONTENT_CACHE_SIZE);
+	if (!sizeStr.empty())
+		contentCacheSize = ConfigData::sizeToBytes(DirectiveKeys::CONTENT_CACHE_SIZE, sizeStr, 0, MAX_CONTENT_CACHE_SIZE);
+	std::string maxFileSizeStr = extractDirectiveValue(DirectiveKeys::CONTENT_CACHE_MAX_FILE_SIZE);
+	if (!maxFileSizeStr.empty())
+		contentCacheMaxFileSize = ConfigData::sizeToBytes(DirectiveKeys::CONTENT_CACHE_MAX_FILE_SIZE, maxFileSizeStr, 1, MAX_CONTENT_CACHE_SIZE);
+}
+
+EventEngine GlobalConfig::getEventEngine() const
+{
+	return eventEngine;
+}
+
+int GlobalConfig::getWorkerThreads() const
+{
+	return workerThreads;
+}
+
+int GlobalConfig::getAcceptBudget() const
+{
+	return acceptBudget;
+}
+
+size_t GlobalConfig::getMaxConnections() const
+{
+	return maxConnections;
+}
+
+size_t GlobalConfig::getOpenFileCache() const
+{
+	return openFileCache;
+}
+
+size_t GlobalConfig::getOpenFileCacheValidMs() const
+{
+	return openFileCacheValidMs;
+}
+
+bool GlobalConfig::getOpenFileCacheErrors() const
+{
+	return openFileCacheErrors;
+}
+
+size_t GlobalConfig::getContentCacheSize() const
+{
+	return contentCacheSize;
+}
+
+size_t GlobalConfig::getContentCacheMaxFileSize() const
+{
+	return contentCacheMaxFileSize;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include <sstream>
+#include <string>
+#include <regex>
+
+#include "ConfigData.hpp"
+#include "../defines.hpp"
+
+/* Directives that live outside of any server block and apply to the whole process,
+ * e.g. which event engine the server loop uses.
+ */
+class GlobalConfig
+{
+public:
+	GlobalConfig();
+	GlobalConfig(const std::string &input);
+	GlobalConfig(const GlobalConfig &other);
+	GlobalConfig &operator=(const GlobalConfig &other);
+	~GlobalConfig();
+
+	void analyzeGlobalConfig();
+	void printGlobalConfig();
+
+	EventEngine getEventEngine() const;
+	int getWorkerThreads() const;
+	int getAcceptBudget() const;
+	size_t getMaxConnections() const;
+	size_t getOpenFileCache() const;
+	size_t getOpenFileCacheValidMs() const;
+	bool getOpenFileCacheErrors() const;
+	size_t getContentCacheSize() const;
+	size_t getContentCacheMaxFileSize() const;
+
+private:
+	std::string globalBlock;
+	EventEngine eventEngine;
+	int workerThreads;
+	int acceptBudget;
+	size_t maxConnections;
+	size_t openFileCache;
+	size_t openFileCacheValidMs;
+	bool openFileCacheErrors;
+	size_t contentCacheSize;
+	size_t contentCacheMaxFileSize;
+
+	std::string extractDirectiveValue(const std::string &directiveKey);
+	void extractEventEngine();
+	void extractWorkerThreads();
+	void extractAcceptBudget();
+	void extractMaxConnections();
+	void extractOpenFileCache();
+	void extractContentCache();
+};
@@ -8,12 +8,23 @@ Location::Location(const std::string &input)
 	root = "";
 	alias = "";
 	directoryListing = false;
+	sendFile = true;
+	gzipStatic = false;
+	gzip = false;
+	gzipTypes = {ContentType::TEXT_HTML};
+	gzipMinLength = DEFAULT_GZIP_MIN_LENGTH;
 	defaultFile = "index.html";
 	redirectionRoute = "";
 	saveDirIsEmpty = true;
 	aliasIsEmpty = true;
 	rootIsEmpty = true;
 	redirectionIsEmpty = true;
+	maxBodySize = 0; // set by the server block that owns the location
+}
+
+Location::Location(const Location &other)
+{
+	*this = other;
 }
 
 Location &Location::operator=(const Location &other)
@@ -29,12 +40,18 @@ Location &Location::operator=(const Location &other)
 	root = other.root;
 	alias = other.alias;
 	directoryListing = other.directoryListing;
+	sendFile = other.sendFile;
+	gzipStatic = other.gzipStatic;
+	gzip = other.gzip;
+	gzipTypes = other.gzipTypes;
+	gzipMinLength = other.gzipMinLength;
 	defaultFile = other.defaultFile;
 	saveDir = other.saveDir;
 	saveDirIsEmpty = other.saveDirIsEmpty;
 	aliasIsEmpty = other.aliasIsEmpty;
 	rootIsEmpty = other.rootIsEmpty;
 	redirectionIsEmpty = other.redirectionIsEmpty;
+	maxBodySize = other.maxBodySize;
 	return *this;
 }
 
@@ -70,6 +87,9 @@ void Location::analyzeLocationData()
 		throw std::runtime_error("Don't have both root and alias set in location block: " + locationBlock);
 	} */
 	setDirectoryListing();
+	setSendFile();
+	setGzipStatic();
+	setGzip();
 	setDefaultFile();
 	setSaveDir();
 	// setCgiExtension();
@@ -214,6 +234,64 @@ void Location::setDirectoryListing()
 	}
 }
 
+// files of the location are sent with sendfile() unless "sendfile off;"
+void Location::setSendFile()
+{
+	std::regex sendFileRegex("sendfile\\s+(on|off)\\;");
+	std::smatch match;
+	if (std::regex_search(locationBlock, match, sendFileRegex))
+	{
+		std::string value = match[1].str();
+		sendFile = value == "on";
+	}
+}
+
+// with "gzip_static on;" a precompressed file.gz or file.br is sent instead of file when the client accepts it
+void Location::setGzipStatic()
+{
+	std::regex gzipStaticRegex("gzip_static\\s+(on|off)\\;");
+	std::smatch match;
+	if (std::regex_search(locationBlock, match, gzipStaticRegex))
+	{
+		std::string value = match[1].str();
+		gzipStatic = value == "on";
+	}
+}
+
+/* "gzip on;" compresses bodies of the types in "gzip_types" (text/html is always one of them)
+that are at least "gzip_min_length" bytes long, for clients that accept gzip.
+Handling error:
+- Unknown content type
+- gzip_min_length not a number
+*/
+void Location::setGzip()
+{
+	std::regex gzipRegex("(^|\\s)gzip\\s+(on|off)\\;");
+	std::smatch match;
+	if (std::regex_search(locationBlock, match, gzipRegex))
+		gzip = match[2].str() == "on";
+	std::regex gzipTypesRegex("gzip_types\\s+([^;]+)\\;");
+	if (std::regex_search(locationBlock, match, gzipTypesRegex))
+	{
+		std::istringstream types(match[1].str());
+		std::string type;
+		while (types >> type)
+		{
+			auto it = HttpUtils::_contentTypes.find(type);
+			if (it == HttpUtils::_contentTypes.end())
+				throw std::runtime_error("Invalid gzip type: " + type);
+			gzipTypes.insert(it->second);
+		}
+	}
+	std::string minLength = extractDirectiveValue("gzip_min_length");
+	if (!minLength.empty())
+	{
+		if (!StringUtils::isDigitsOnly(minLength) || minLength.size() > 9)
+			throw std::runtime_error("Invalid gzip_min_length: " + minLength);
+		gzipMinLength = StringUtils::strToSizeT(minLength);
+	}
+}
+
 std::string Location::extractDirectiveValue(const std::string &directiveKey)
 {
 	std::istringstream stream(locationBlock);
@@ -315,6 +393,31 @@ bool Location::getDirectoryListing()
 	return directoryListing;
 }
 
+bool Location::getSendFile()
+{
+	return sendFile;
+}
+
+bool Location::getGzipStatic()
+{
+	return gzipStatic;
+}
+
+bool Location::getGzip()
+{
+	return gzip;
+}
+
+std::unordered_set<ContentType> Location::getGzipTypes()
+{
+	return gzipTypes;
+}
+
+size_t Location::getGzipMinLength()
+{
+	return gzipMinLength;
+}
+
 std::string Location::getDefaultFile()
 {
 	return defaultFile;
@@ -353,4 +456,14 @@ bool Location::getRootIsEmpty()
 bool Location::getRedirectionIsEmpty()
 {
 	return redirectionIsEmpty;
+}
+
+size_t Location::getMaxBodySize()
+{
+	return maxBodySize;
+}
+
+void Location::setMaxBodySize(size_t const &size)
+{
+	maxBodySize = size;
 }
\ No newline at end of file
@@ -23,6 +23,7 @@ class Location
 public:
 	Location();
 	Location(const std::string &input);
+	Location(const Location &other);
 	Location &operator=(const Location &other);
 	~Location();
 
@@ -36,6 +37,11 @@ public:
 	std::string getLocationRoot();
 	std::string getLocationAlias();
 	bool getDirectoryListing();
+	bool getSendFile();
+	bool getGzipStatic();
+	bool getGzip();
+	std::unordered_set<ContentType> getGzipTypes();
+	size_t getGzipMinLength();
 	std::string getDefaultFile();
 	std::string getSaveDir();
 	void setLocationRoot(const std::string &root);
@@ -44,6 +50,8 @@ public:
 	bool getAliasIsEmpty();
 	bool getRootIsEmpty();
 	bool getRedirectionIsEmpty();
+	size_t getMaxBodySize();
+	void setMaxBodySize(size_t const &size);
 
 private:
 	std::string locationBlock;
@@ -53,12 +61,18 @@ private:
 	std::string root;
 	std::string alias;
 	bool directoryListing;
+	bool sendFile;
+	bool gzipStatic;
+	bool gzip;
+	std::unordered_set<ContentType> gzipTypes;
+	size_t gzipMinLength;
 	std::string defaultFile;
 	std::string saveDir;
 	bool saveDirIsEmpty;
 	bool aliasIsEmpty;
 	bool rootIsEmpty;
 	bool redirectionIsEmpty;
+	size_t maxBodySize; // client_max_body_size of the location, the server's one if it sets none
 	// std::string cgiExtension;
 	// std::string cgiExecutor;
 	// ... other properties ...
@@ -72,6 +86,9 @@ private:
 	void setLocationRoot();
 	void setLocationAlias();
 	void setDirectoryListing();
+	void setSendFile();
+	void setGzipStatic();
+	void setGzip();
 	void setDefaultFile();
 	void setSaveDir();
 	// void setCgiExtension();
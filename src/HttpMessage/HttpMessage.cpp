@@ -32,7 +32,7 @@ ConfigData const &HttpMessage::getConfig() const
 	return this->_config;
 }
 
-std::vector<std::byte> HttpMessage::getBody() const
+std::vector<std::byte> const &HttpMessage::getBody() const
 {
 	return this->_body;
 }
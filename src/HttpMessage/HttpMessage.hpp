@@ -51,7 +51,7 @@ public:
 	int getHttpVersionMajor() const;
 	int getHttpVersionMinor() const;
 	size_t getContentLength() const;
-	std::vector<std::byte> getBody() const;
+	std::vector<std::byte> const &getBody() const;
 	ConnectionValue getConnection() const;
 	std::chrono::system_clock::time_point getDate() const;
 	ContentType getContentType() const;
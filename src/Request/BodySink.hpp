@@ -0,0 +1,17 @@
+#ifndef BODYSINK_HPP
+#define BODYSINK_HPP
+
+#include <cstddef>
+
+/* Where the bytes of a request body go as they are received: the body itself (RequestBody), or a
+ * parser that takes it apart on the way (MultipartParser). The chunked decoder writes into either.
+ */
+class BodySink
+{
+public:
+	virtual ~BodySink() = default;
+
+	virtual void append(const std::byte *data, size_t const &bytes) = 0;
+};
+
+#endif
@@ -0,0 +1,123 @@
+#include "ChunkedDecoder.hpp"
+
+ChunkedDecoder::ChunkedDecoder(size_t const &maxBodySize)
+	: state(CHUNK_SIZE), chunkSize(0), sizeDigits(0), lineLength(0), maxBodySize(maxBodySize), decodedSize(0) {}
+
+unsigned int ChunkedDecoder::hexValue(unsigned char const &c)
+{
+	if (std::isdigit(c))
+		return (c - '0');
+	return (std::tolower(c) - 'a' + 10);
+}
+
+/* Feeds the next part of the body, consumed is set to the input bytes that belonged to it.
+ * Returns CHUNKED_COMPLETE once the last chunk and the trailer section were read, the bytes after
+ * them are left to the caller as they start the next request.
+ */
+ChunkedDecoder::Status ChunkedDecoder::decode(const std::byte *input, size_t const &size, BodySink &body, size_t &consumed)
+{
+	consumed = 0;
+	while (consumed < size && state != BODY_DONE)
+	{
+		if (state == CHUNK_DATA)
+		{
+			size_t length = std::min(chunkSize, size - consumed);
+			body.append(input + consumed, length);
+			chunkSize -= length;
+			decodedSize += length;
+			consumed += length;
+			if (chunkSize == 0)
+				state = CHUNK_DATA_CR;
+			continue;
+		}
+		Status status = decodeLineByte(static_cast<unsigned char>(input[consumed++]));
+		if (status != CHUNKED_INCOMPLETE)
+			return (status);
+	}
+	return (state == BODY_DONE ? CHUNKED_COMPLETE : CHUNKED_INCOMPLETE);
+}
+
+// one byte of a size line, the CRLF after chunk data or the trailer section
+ChunkedDecoder::Status ChunkedDecoder::decodeLineByte(unsigned char const &c)
+{
+	if (++lineLength > CHUNKED_MAX_LINE_LENGTH)
+		return (CHUNKED_BAD_SYNTAX);
+	switch (state)
+	{
+	case CHUNK_SIZE:
+		if (std::isxdigit(c))
+		{
+			size_t remaining = maxBodySize - decodedSize;
+			if (chunkSize > remaining / 16 || chunkSize * 16 + hexValue(c) > remaining)
+				return (CHUNKED_TOO_LARGE);
+			chunkSize = chunkSize * 16 + hexValue(c);
+			++sizeDigits;
+		}
+		else if (sizeDigits == 0)
+			return (CHUNKED_BAD_SYNTAX);
+		else if (c == ';' || c == ' ' || c == '\t')
+			state = CHUNK_EXTENSION;
+		else if (c == '\r')
+			state = CHUNK_SIZE_LF;
+		else
+			return (CHUNKED_BAD_SYNTAX);
+		break;
+	case CHUNK_EXTENSION: // not used, only checked to stay on the line
+		if (c == '\r')
+			state = CHUNK_SIZE_LF;
+		else if (!RequestParser::isFieldValueChar(c))
+			return (CHUNKED_BAD_SYNTAX);
+		break;
+	case CHUNK_SIZE_LF:
+		if (c != '\n')
+			return (CHUNKED_BAD_SYNTAX);
+		state = (chunkSize == 0) ? TRAILER_START : CHUNK_DATA;
+		sizeDigits = 0;
+		lineLength = 0;
+		break;
+	case CHUNK_DATA_CR:
+		if (c != '\r')
+			return (CHUNKED_BAD_SYNTAX);
+		state = CHUNK_DATA_LF;
+		break;
+	case CHUNK_DATA_LF:
+		if (c != '\n')
+			return (CHUNKED_BAD_SYNTAX);
+		state = CHUNK_SIZE;
+		lineLength = 0;
+		break;
+	case TRAILER_START:
+		if (c == '\r')
+			state = LAST_LF;
+		else if (RequestParser::isTokenChar(c))
+			state = TRAILER_FIELD;
+		else
+			return (CHUNKED_BAD_SYNTAX);
+		break;
+	case TRAILER_FIELD: // trailer fields are dropped
+		if (c == '\r')
+			state = TRAILER_FIELD_LF;
+		else if (!RequestParser::isFieldValueChar(c))
+			return (CHUNKED_BAD_SYNTAX);
+		break;
+	case TRAILER_FIELD_LF:
+		if (c != '\n')
+			return (CHUNKED_BAD_SYNTAX);
+		state = TRAILER_START;
+		lineLength = 0;
+		break;
+	case LAST_LF:
+		if (c != '\n')
+			return (CHUNKED_BAD_SYNTAX);
+		state = BODY_DONE;
+		break;
+	default:
+		break;
+	}
+	return (CHUNKED_INCOMPLETE);
+}
+
+size_t ChunkedDecoder::getDecodedSize() const
+{
+	return (decodedSize);
+}
@@ -0,0 +1,64 @@
+#ifndef CHUNKEDDECODER_HPP
+#define CHUNKEDDECODER_HPP
+
+#include <vector>
+#include <cstddef>
+#include <limits>
+#include <cctype>
+#include <algorithm>
+
+#include "RequestParser.hpp"
+#include "BodySink.hpp"
+#include "../defines.hpp"
+
+/* Decodes a chunked request body (RFC 9112 7.1) as it arrives, whatever way it is split over reads.
+ * Every input byte is looked at once: chunk data is appended to the body in one go, the size
+ * lines, chunk extensions and trailer fields are checked byte by byte and then dropped. The size is
+ * accumulated digit by digit and rejected as soon as it would go over the body size limit, so a
+ * huge size cannot overflow.
+ */
+class ChunkedDecoder
+{
+public:
+	enum Status
+	{
+		CHUNKED_INCOMPLETE,
+		CHUNKED_COMPLETE,
+		CHUNKED_BAD_SYNTAX,
+		CHUNKED_TOO_LARGE
+	};
+
+private:
+	enum State
+	{
+		CHUNK_SIZE,
+		CHUNK_EXTENSION,
+		CHUNK_SIZE_LF,
+		CHUNK_DATA,
+		CHUNK_DATA_CR,
+		CHUNK_DATA_LF,
+		TRAILER_START,
+		TRAILER_FIELD,
+		TRAILER_FIELD_LF,
+		LAST_LF,
+		BODY_DONE
+	};
+
+	State state;
+	size_t chunkSize;  // the size being read, then the data bytes left of the chunk
+	size_t sizeDigits;
+	size_t lineLength; // of the current size or trailer line
+	size_t maxBodySize;
+	size_t decodedSize;
+
+	static unsigned int hexValue(unsigned char const &c);
+	Status decodeLineByte(unsigned char const &c);
+
+public:
+	ChunkedDecoder(size_t const &maxBodySize = std::numeric_limits<size_t>::max());
+
+	Status decode(const std::byte *input, size_t const &size, BodySink &body, size_t &consumed);
+	size_t getDecodedSize() const;
+};
+
+#endif
@@ -0,0 +1,207 @@
+#include "MultipartParser.hpp"
+
+// the body starts with a delimiter that has no CRLF in front of it, one is held back to match it the same way
+MultipartParser::MultipartParser(std::string const &boundary, size_t const &bufferSize)
+	: state(PREAMBLE), delimiter(CRLF "--" + boundary), pending(CRLF), bufferSize(bufferSize), memoryUsed(0),
+	  receivedSize(0) {}
+
+void MultipartParser::append(const std::byte *data, size_t const &bytes)
+{
+	const char *input = reinterpret_cast<const char *>(data);
+	size_t left = bytes;
+
+	receivedSize += bytes;
+	while (left > 0 && !isFinished())
+	{
+		if (pending.empty())
+		{
+			size_t used = parse(input, left);
+			pending.assign(input + used, left - used);
+			break;
+		}
+		// the held back bytes are decided together with the next ones, only as many as that may take are copied
+		size_t taken = std::min(left, std::max(delimiter.size(), static_cast<size_t>(MULTIPART_MAX_HEADER_SIZE)));
+		pending.append(input, taken);
+		size_t used = parse(pending.data(), pending.size());
+		size_t unused = pending.size() - used;
+		if (unused <= taken) // the held back bytes are through, the rest is parsed from the input again
+		{
+			pending.clear();
+			input += taken - unused;
+			left -= taken - unused;
+		}
+		else
+		{
+			pending.erase(0, used);
+			input += taken;
+			left -= taken;
+		}
+	}
+	if (isFinished())
+		pending.clear();
+}
+
+// nothing that comes after is looked at
+bool MultipartParser::isFinished() const
+{
+	return (state == EPILOGUE || state == FAILED || state == TOO_MANY_PARTS);
+}
+
+// as much of the input as can be decided on, returns the bytes used
+size_t MultipartParser::parse(const char *input, size_t const &size)
+{
+	size_t used = 0;
+
+	while (used < size)
+	{
+		size_t step = 0;
+		switch (state)
+		{
+		case PREAMBLE:
+		case PART_DATA:
+			step = parseData(input + used, size - used);
+			break;
+		case DELIMITER_END:
+			step = parseDelimiterEnd(input + used, size - used);
+			break;
+		case PART_HEADERS:
+			step = parseHeaders(input + used, size - used);
+			break;
+		default: // the epilogue, or after an error or too many parts
+			return (size);
+		}
+		if (step == 0)
+			break;
+		used += step;
+	}
+	return (used);
+}
+
+// the data of a part, or the preamble which is dropped, up to the next delimiter
+size_t MultipartParser::parseData(const char *input, size_t const &size)
+{
+	size_t position = ByteScanner::find(input, size, delimiter.data(), delimiter.size());
+	size_t dataSize = (position == ByteScanner::npos) ? size - partialDelimiterLength(input, size) : position;
+
+	if (state == PART_DATA)
+		parts.back().body.append(reinterpret_cast<const std::byte *>(input), dataSize);
+	if (position == ByteScanner::npos)
+		return (dataSize);
+	if (state == PART_DATA)
+		endPart();
+	state = DELIMITER_END;
+	return (position + delimiter.size());
+}
+
+// the end of the input that may be the start of a delimiter
+size_t MultipartParser::partialDelimiterLength(const char *input, size_t const &size) const
+{
+	size_t from = (size >= delimiter.size()) ? size - delimiter.size() + 1 : 0;
+
+	for (size_t i = from; i < size; ++i)
+	{
+		if (input[i] == '\r' && std::memcmp(input + i, delimiter.data(), size - i) == 0)
+			return (size - i);
+	}
+	return (0);
+}
+
+// "--" after the delimiter closes the body, otherwise the line ends after optional transport padding
+size_t MultipartParser::parseDelimiterEnd(const char *input, size_t const &size)
+{
+	if (size < 2)
+		return (0);
+	if (input[0] == '-' && input[1] == '-')
+	{
+		state = EPILOGUE;
+		return (2);
+	}
+	size_t padding = 0;
+	while (padding < size && (input[padding] == ' ' || input[padding] == '\t'))
+		++padding;
+	if (size - padding < 2)
+	{
+		if (size > MULTIPART_MAX_HEADER_SIZE)
+			state = FAILED;
+		return (0);
+	}
+	if (input[padding] != '\r' || input[padding + 1] != '\n')
+	{
+		state = FAILED;
+		return (0);
+	}
+	state = PART_HEADERS;
+	return (padding + 2);
+}
+
+size_t MultipartParser::parseHeaders(const char *input, size_t const &size)
+{
+	if (size >= 2 && input[0] == '\r' && input[1] == '\n') // a part without headers
+	{
+		startPart("");
+		return (2);
+	}
+	size_t searched = std::min(size, static_cast<size_t>(MULTIPART_MAX_HEADER_SIZE));
+	size_t end = ByteScanner::find(input, searched, CRLF CRLF, sizeof(CRLF CRLF) - 1);
+	if (end == ByteScanner::npos)
+	{
+		if (size >= MULTIPART_MAX_HEADER_SIZE)
+			state = FAILED;
+		return (0);
+	}
+	startPart(std::string(input, end + 2)); // every line with its CRLF
+	return (end + sizeof(CRLF CRLF) - 1);
+}
+
+void MultipartParser::startPart(std::string const &headers)
+{
+	if (parts.size() == MULTIPART_MAX_PARTS)
+	{
+		state = TOO_MANY_PARTS;
+		return;
+	}
+	memoryUsed += headers.size(); // about what the header map of the part holds
+	Part part{{}, RequestBody(bufferSize - std::min(memoryUsed, bufferSize))};
+	size_t lineStart = 0;
+
+	while (lineStart < headers.size())
+	{
+		size_t lineEnd = headers.find(CRLF, lineStart);
+		std::string line = headers.substr(lineStart, lineEnd - lineStart);
+		lineStart = lineEnd + 2;
+		size_t colon = line.find(':');
+		if (colon == std::string::npos)
+			continue;
+		std::string name = StringUtils::trim(line.substr(0, colon));
+		std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+		part.headers[name] = StringUtils::trim(line.substr(colon + 1));
+	}
+	parts.push_back(std::move(part));
+	state = PART_DATA;
+}
+
+void MultipartParser::endPart()
+{
+	if (!parts.back().body.isSpooled())
+		memoryUsed += parts.back().body.getSize();
+}
+
+MultipartParser::Status MultipartParser::getStatus() const
+{
+	if (state == FAILED)
+		return (MULTIPART_BAD_SYNTAX);
+	if (state == TOO_MANY_PARTS)
+		return (MULTIPART_TOO_LARGE);
+	return (state == EPILOGUE ? MULTIPART_COMPLETE : MULTIPART_INCOMPLETE);
+}
+
+std::vector<MultipartParser::Part> const &MultipartParser::getParts() const
+{
+	return (parts);
+}
+
+// all of the body, up to its end and not only the parts
+size_t MultipartParser::getReceivedSize() const
+{
+	return (receivedSize);
+}
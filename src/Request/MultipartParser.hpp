@@ -0,0 +1,84 @@
+#ifndef MULTIPARTPARSER_HPP
+#define MULTIPARTPARSER_HPP
+
+#include <map>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+
+#include "BodySink.hpp"
+#include "RequestBody.hpp"
+#include "../Utils/ByteScanner.hpp"
+#include "../Utils/StringUtils.hpp"
+#include "../defines.hpp"
+
+/* Takes a multipart/form-data body (RFC 7578) apart while it is received, whatever way it is split
+ * over reads. The data of each part goes straight into the part's own RequestBody, so the body as a
+ * whole is never stored: parts are kept in memory while all of them together fit in the buffer
+ * size, the rest is spooled to temporary files as it arrives. Only the bytes that may be the start
+ * of a delimiter, or the headers of a part, are held back until the next bytes decide about them.
+ * The headers of the parts count against the buffer size too, and the number of parts is capped as
+ * each spooled part keeps its temporary file open until the request is done. Everything after the
+ * close delimiter is ignored.
+ */
+class MultipartParser : public BodySink
+{
+public:
+	enum Status
+	{
+		MULTIPART_INCOMPLETE,
+		MULTIPART_COMPLETE,
+		MULTIPART_BAD_SYNTAX,
+		MULTIPART_TOO_LARGE // more parts than MULTIPART_MAX_PARTS
+	};
+
+	struct Part
+	{
+		std::map<std::string, std::string> headers; // names in lowercase
+		RequestBody body;
+	};
+
+private:
+	enum State
+	{
+		PREAMBLE,
+		DELIMITER_END, // transport padding and CRLF, or the "--" of the close delimiter
+		PART_HEADERS,
+		PART_DATA,
+		EPILOGUE,
+		FAILED,
+		TOO_MANY_PARTS
+	};
+
+	State state;
+	std::string delimiter; // CRLF "--" boundary, the CRLF in front of it is not part of the data
+	std::string pending;   // held back from the previous bytes
+	std::vector<Part> parts;
+	size_t bufferSize;
+	size_t memoryUsed; // by the headers of the parts and the parts that were not spooled
+	size_t receivedSize;
+
+	MultipartParser(const MultipartParser &) = delete;
+	MultipartParser &operator=(const MultipartParser &) = delete;
+
+	size_t parse(const char *input, size_t const &size);
+	size_t parseData(const char *input, size_t const &size);
+	size_t parseDelimiterEnd(const char *input, size_t const &size);
+	size_t parseHeaders(const char *input, size_t const &size);
+	size_t partialDelimiterLength(const char *input, size_t const &size) const;
+	bool isFinished() const;
+	void startPart(std::string const &headers);
+	void endPart();
+
+public:
+	MultipartParser(std::string const &boundary, size_t const &bufferSize);
+
+	void append(const std::byte *data, size_t const &bytes) override;
+	Status getStatus() const;
+	std::vector<Part> const &getParts() const;
+	size_t getReceivedSize() const;
+};
+
+#endif
@@ -2,10 +2,10 @@
 
 void Request::printRequestProperties() const
 {
-	std::cout << "method: " << this->_requestLine.method << std::endl;
-	std::cout << "requestTarget: " << this->_requestLine.requestTarget << std::endl;
-	std::cout << "HTTPVersionMajor: " << this->_requestLine.HTTPVersionMajor << std::endl;
-	std::cout << "HTTPVersionMinor: " << this->_requestLine.HTTPVersionMinor << std::endl;
+	std::cout << "method: " << getMethodStr() << std::endl;
+	std::cout << "requestTarget: " << this->_target << std::endl;
+	std::cout << "HTTPVersionMajor: " << this->_httpVersionMajor << std::endl;
+	std::cout << "HTTPVersionMinor: " << this->_httpVersionMinor << std::endl;
 	std::cout << "host: " << this->_host << std::endl;
 	std::cout << "port: " << this->_port << std::endl;
 	std::cout << "server name: " << this->_config.getServerName() << std::endl;
@@ -29,11 +29,64 @@ bool Request::isBodyExpected() const
 	return this->_bodyExpected;
 }
 
+bool Request::expectsContinue() const
+{
+	return this->_expectContinue;
+}
+
+size_t Request::getMaxBodySize() const
+{
+	return this->_maxBodySize;
+}
+
+RequestBody const &Request::getBody() const
+{
+	return this->_requestBody;
+}
+
+// null unless the body is multipart/form-data for an upload, then getBody() stays empty
+MultipartParser const *Request::getMultipartParser() const
+{
+	return this->_multipartParser.get();
+}
+
+size_t Request::getBodySize() const
+{
+	if (this->_multipartParser)
+		return this->_multipartParser->getReceivedSize();
+	return this->_requestBody.getSize();
+}
+
 std::string Request::getUserAgent() const
 {
 	return this->_userAgent;
 }
 
+bool Request::acceptsEncoding(const std::string &coding) const
+{
+	return this->_acceptedEncodings.count(coding) > 0;
+}
+
+std::vector<Request::ByteRange> const &Request::getRanges() const
+{
+	return this->_ranges;
+}
+
+std::string Request::getIfRange() const
+{
+	return this->_ifRange;
+}
+
+std::string Request::getIfNoneMatch() const
+{
+	return this->_ifNoneMatch;
+}
+
+std::string Request::getIfModifiedSince() const
+{
+	return this->_ifModifiedSince;
+}
+
 std::string Request::getHost() const
 {
 	return this->_host;
@@ -46,68 +99,62 @@ std::string Request::getTransferEncoding() const
 
 std::string Request::getMethodStr() const
 {
-	return this->_requestLine.method;
+	auto it = HttpUtils::_httpMethodToStr.find(this->_method);
+	if (it == HttpUtils::_httpMethodToStr.end())
+	{
+		return "";
+	}
+	return it->second;
 }
 
 // MODIFIERS
 
+// the body, or the multipart parser that takes it apart
+BodySink &Request::getBodySink()
+{
+	if (this->_multipartParser)
+		return *this->_multipartParser;
+	return this->_requestBody;
+}
+
 void Request::appendToBody(const std::vector<std::byte> &newBodyChunk)
 {
-	this->_body.insert(this->_body.end(), newBodyChunk.begin(), newBodyChunk.end());
+	getBodySink().append(newBodyChunk.data(), newBodyChunk.size());
 }
 
-void Request::appendToBody(char newBodyChunk[], const ssize_t &bytes)
+void Request::appendToBody(const char newBodyChunk[], const size_t &bytes)
 {
-	for (ssize_t i = 0; i < bytes; ++i)
-		this->_body.push_back(static_cast<std::byte>(newBodyChunk[i]));
+	getBodySink().append(reinterpret_cast<const std::byte *>(newBodyChunk), bytes);
 }
 
-void Request::resizeBody(const size_t &n)
+// the next part of a chunked body, decoded straight into the body
+ChunkedDecoder::Status Request::appendChunkedBody(const std::byte data[], const size_t &size, size_t &consumed)
 {
-	this->_body.resize(n);
+	return this->_chunkedDecoder.decode(data, size, getBodySink(), consumed);
 }
 
 // PARSING
 
 // REQUEST LINE
 
-void Request::extractRequestLine(const std::string &requestLine)
+// the method is matched case-insensitively against all methods HTTP knows, then exactly against the implemented ones
+void Request::validateMethod(std::string_view const &method)
 {
-	std::regex requestLineRegex(REQUEST_LINE_REGEX);
-	std::smatch match;
-	if (std::regex_match(requestLine, match, requestLineRegex))
-	{
-		this->_requestLine.method = match[1];
-		this->_requestLine.requestTarget = match[2];
-		this->_requestLine.HTTPVersionMajor = match[3];
-		if (match[4].matched)
-		{
-			this->_requestLine.HTTPVersionMinor = match[4];
-		}
-	}
-	else
-	{
-		throw BadRequestException("Request line extraction error");
-	}
-}
-
-void Request::validateMethod()
-{
-	std::vector<std::string> validMethods = VALID_HTTP_METHODS;
-	std::string method = this->_requestLine.method;
-	std::transform(method.begin(), method.end(), method.begin(), ::toupper);
+	static const char *const validMethods[] = VALID_HTTP_METHODS;
 
-	auto itValid = std::find(validMethods.begin(), validMethods.end(), method);
-	if (itValid == validMethods.end())
+	auto itValid = std::find_if(std::begin(validMethods), std::end(validMethods),
+								[&method](const char *validMethod)
+								{ return StringUtils::equalsIgnoreCase(method, validMethod); });
+	if (itValid == std::end(validMethods))
 	{
 		this->_statusCode = HttpStatusCode::METHOD_NOT_ALLOWED;
 		throw BadRequestException("Method not allowed");
 	}
 }
 
-HttpMethod Request::matchValidMethod()
+HttpMethod Request::matchValidMethod(std::string_view const &method)
 {
-	auto it = HttpUtils::_strToHttpMethod.find(this->_requestLine.method);
+	auto it = HttpUtils::_strToHttpMethod.find(std::string(method));
 	if (it == HttpUtils::_strToHttpMethod.end())
 	{
 		this->_statusCode = HttpStatusCode::NOT_IMPLEMENTED;
@@ -116,27 +163,59 @@ HttpMethod Request::matchValidMethod()
 	return it->second;
 }
 
-HttpMethod Request::parseMethod()
+HttpMethod Request::parseMethod(std::string_view const &method)
 {
-	validateMethod();
-	return matchValidMethod();
+	validateMethod(method);
+	return matchValidMethod(method);
 }
 
-std::string Request::parseTarget()
+// a number of at most 5 digits, already checked to be digits only
+int Request::parseDigits(std::string_view const &digits)
 {
-	std::string target = this->_requestLine.requestTarget;
-	std::regex targetRegex(URL_REGEX);
-	if (!std::regex_match(target, targetRegex))
+	int number = 0;
+	for (char digit : digits)
+	{
+		number = number * 10 + (digit - '0');
+	}
+	return number;
+}
+
+// "first-last" with up to RANGE_MAX_DIGITS digits on each side, one of them may be left out (-1)
+bool Request::parseRangeSpec(std::string_view const &spec, ByteRange &range)
+{
+	size_t dash = spec.find('-');
+	if (dash == std::string_view::npos)
+	{
+		return false;
+	}
+	std::string_view const positions[] = {spec.substr(0, dash), spec.substr(dash + 1)};
+	long long values[] = {-1, -1};
+	for (size_t i = 0; i < 2; ++i)
+	{
+		if (positions[i].size() > RANGE_MAX_DIGITS)
+		{
+			return false;
+		}
+		for (char digit : positions[i])
+		{
+			if (!std::isdigit(static_cast<unsigned char>(digit)))
+			{
+				return false;
+			}
+			values[i] = (values[i] < 0 ? 0 : values[i] * 10) + (digit - '0');
+		}
+	}
+	if (positions[0].empty() && positions[1].empty())
 	{
-		throw BadRequestException("Target parsing error");
+		return false;
 	}
-	return target;
+	range = {values[0], values[1]};
+	return range.first < 0 || range.last < 0 || range.first <= range.last;
 }
 
-int Request::parseMajorVersion()
+int Request::parseMajorVersion(std::string_view const &majorDigits)
 {
-	// no need to handle exceptions because we already know it's 1-3 digits thanks to regex
-	int major = std::stoi(this->_requestLine.HTTPVersionMajor);
+	int major = parseDigits(majorDigits);
 	if (major > 1)
 	{
 		this->_statusCode = HttpStatusCode::HTTP_VERSION_NOT_SUPPORTED;
@@ -150,14 +229,9 @@ int Request::parseMajorVersion()
 	return major;
 }
 
-int Request::parseMinorVersion()
+int Request::parseMinorVersion(std::string_view const &minorDigits)
 {
-	// no need to handle exceptions because we already know it's 1-3 digits thanks to regex
-	if (this->_requestLine.HTTPVersionMinor.empty())
-	{
-		this->_requestLine.HTTPVersionMinor = "1";
-	}
-	int minor = std::stoi(this->_requestLine.HTTPVersionMinor);
+	int minor = minorDigits.empty() ? 1 : parseDigits(minorDigits);
 	if (minor > 1)
 	{
 		this->_statusCode = HttpStatusCode::HTTP_VERSION_NOT_SUPPORTED;
@@ -170,12 +244,12 @@ int Request::parseMinorVersion()
 	return minor;
 }
 
-void Request::parseRequestLine()
+void Request::parseRequestLine(RequestParser::RequestLine const &requestLine)
 {
-	this->_method = parseMethod();
-	this->_target = parseTarget();
-	this->_httpVersionMajor = parseMajorVersion();
-	this->_httpVersionMinor = parseMinorVersion();
+	this->_method = parseMethod(requestLine.method);
+	this->_target = requestLine.target;
+	this->_httpVersionMajor = parseMajorVersion(requestLine.versionMajor);
+	this->_httpVersionMinor = parseMinorVersion(requestLine.versionMinor);
 }
 
 // HEADERS
@@ -199,47 +273,72 @@ void Request::matchConfig()
 	this->_config = *it;
 }
 
-void Request::parseHost()
+// the same test as the response's: the extension of the last path segment is one of cgi_exten
+bool Request::targetsCgi() const
+{
+	std::string segment = this->_target.substr(this->_target.find_last_of('/') + 1);
+	size_t dotPos = segment.find_last_of('.');
+	if (dotPos == std::string::npos)
+		return false;
+	std::string extension = segment.substr(dotPos, segment.find('?', dotPos) - dotPos);
+	return this->_config.getCgiExtenExecutorMap().count(extension) > 0;
+}
+
+// the client_max_body_size of the location the target falls into, looked up only for requests that have a body
+size_t Request::matchMaxBodySize()
 {
-	if (this->_headerLines.find("host") == this->_headerLines.end())
+	try
 	{
-		throw BadRequestException("Host header not found");
+		this->_maxBodySize = this->_config.getMatchingLocation(this->_target).getMaxBodySize();
 	}
-	std::regex hostRegex(HOST_REGEX);
-	std::smatch match;
-	if (!std::regex_match(this->_headerLines["host"], match, hostRegex))
+	catch (const std::exception &e)
 	{
-		throw BadRequestException("Host header parsing error");
+		this->_maxBodySize = this->_config.getMaxClientBodySize(); // no location, the response will be a 404
+	}
+	return this->_maxBodySize;
+}
+
+// "host:port", both parts are needed to find the config
+void Request::parseHost(RequestParser const &head)
+{
+	std::string_view const *hostValue = head.findHeader("host");
+	if (hostValue == nullptr)
+	{
+		throw BadRequestException("Host header not found");
 	}
-	this->_host = match[1];
-	if (StringUtils::isDigitsOnly(match[2]))
+	size_t colon = hostValue->find(':');
+	if (colon == 0 || colon == std::string_view::npos || hostValue->find(':', colon + 1) != std::string_view::npos ||
+		colon + 1 == hostValue->size())
 	{
-		this->_port = std::stoi(match[2]);
+		throw BadRequestException("Host header parsing error");
 	}
-	else
+	std::string_view port = hostValue->substr(colon + 1);
+	if (port.size() > 5 || !std::all_of(port.begin(), port.end(), [](unsigned char c)
+										{ return std::isdigit(c); }))
 	{
 		throw BadRequestException("Port is not only numbers");
 	}
+	this->_host = hostValue->substr(0, colon);
+	this->_port = parseDigits(port);
 	matchConfig();
 }
 
-void Request::parseContentLength()
+void Request::parseContentLength(RequestParser const &head)
 {
-	auto it = this->_headerLines.find("content-length");
-	if (it == this->_headerLines.end())
+	std::string_view const *contentLengthValue = head.findHeader("content-length");
+	if (contentLengthValue == nullptr)
 	{
 		return;
 	}
-	std::string contentLengthValue = it->second;
 	try
 	{
-		this->_contentLength = StringUtils::strToSizeT(contentLengthValue);
+		this->_contentLength = StringUtils::strToSizeT(std::string(*contentLengthValue));
 	}
 	catch (const std::exception &e)
 	{
 		throw BadRequestException("Content-Length parsing error");
 	}
-	if (this->_contentLength > this->_config.getMaxClientBodySize())
+	if (this->_contentLength > matchMaxBodySize())
 	{
 		this->_statusCode = HttpStatusCode::PAYLOAD_TOO_LARGE;
 		throw BadRequestException("Content-Length too large");
@@ -250,25 +349,24 @@ void Request::parseContentLength()
 	}
 }
 
-void Request::parseTransferEncoding()
+void Request::parseTransferEncoding(RequestParser const &head)
 {
-	auto it = this->_headerLines.find("transfer-encoding");
-	if (it == this->_headerLines.end())
+	std::string_view const *transferEncodingValue = head.findHeader("transfer-encoding");
+	if (transferEncodingValue == nullptr)
 	{
 		return;
 	}
 	// protection from request smuggling
-	if (this->_headerLines.find("content-length") != this->_headerLines.end())
+	if (head.findHeader("content-length") != nullptr)
 	{
 		this->_bodyExpected = false;
 		throw BadRequestException("Transfer-Encoding and Content-Length headers present together");
 	}
-	std::string transferEncodingValue = it->second;
-	std::transform(transferEncodingValue.begin(), transferEncodingValue.end(), transferEncodingValue.begin(), ::tolower);
-	if (transferEncodingValue == "chunked")
+	if (StringUtils::equalsIgnoreCase(*transferEncodingValue, "chunked"))
 	{
 		this->_chunked = true;
 		this->_bodyExpected = true;
+		this->_chunkedDecoder = ChunkedDecoder(matchMaxBodySize());
 	}
 	else
 	{
@@ -277,43 +375,160 @@ void Request::parseTransferEncoding()
 	}
 }
 
-void Request::parseUserAgent()
+void Request::parseUserAgent(RequestParser const &head)
+{
+	std::string_view const *userAgentValue = head.findHeader("user-agent");
+	if (userAgentValue == nullptr)
+	{
+		return;
+	}
+	this->_userAgent = *userAgentValue;
+}
+
+// "0", "0." or "0.000", the qvalue of a coding the client does not want
+bool Request::isZeroQValue(std::string_view const &qValue)
+{
+	if (qValue.empty() || qValue[0] != '0')
+	{
+		return false;
+	}
+	return qValue.size() == 1 ||
+		   (qValue[1] == '.' && qValue.size() <= 5 && qValue.find_first_not_of('0', 2) == std::string_view::npos);
+}
+
+// e.g. "gzip, deflate;q=0.5, br;q=0", codings with a q value of 0 are not accepted
+void Request::parseAcceptEncoding(RequestParser const &head)
+{
+	std::string_view const *acceptEncodingValue = head.findHeader("accept-encoding");
+	if (acceptEncodingValue == nullptr)
+	{
+		return;
+	}
+	std::string_view codings = *acceptEncodingValue;
+	while (!codings.empty())
+	{
+		size_t comma = codings.find(',');
+		std::string_view codingWithParams = codings.substr(0, comma);
+		codings.remove_prefix(comma == std::string_view::npos ? codings.size() : comma + 1);
+		size_t semicolon = codingWithParams.find(';');
+		std::string_view coding = RequestParser::trimWhitespace(codingWithParams.substr(0, semicolon));
+		bool refused = false;
+		while (semicolon != std::string_view::npos)
+		{
+			codingWithParams.remove_prefix(semicolon + 1);
+			semicolon = codingWithParams.find(';');
+			std::string_view param = RequestParser::trimWhitespace(codingWithParams.substr(0, semicolon));
+			if (param.size() > 2 && (param[0] == 'q' || param[0] == 'Q') && param[1] == '=')
+				refused = isZeroQValue(param.substr(2));
+		}
+		if (!coding.empty() && !refused)
+		{
+			std::string lowercaseCoding(coding);
+			std::transform(lowercaseCoding.begin(), lowercaseCoding.end(), lowercaseCoding.begin(), ::tolower);
+			this->_acceptedEncodings.insert(lowercaseCoding);
+		}
+	}
+}
+
+/* "bytes=0-499, 1000-, -500". Satisfying the ranges is up to the response, which knows the size.
+A Range header that does not parse is ignored, as if it was not sent (RFC 9110 14.2).
+*/
+void Request::parseRange(RequestParser const &head)
+{
+	std::string_view const *rangeValue = head.findHeader("range");
+	if (rangeValue == nullptr)
+	{
+		return;
+	}
+	// the unit is matched case-insensitively, the specs after it are separated by commas
+	std::string_view specs = *rangeValue;
+	std::string_view const unit = "bytes=";
+	if (specs.size() <= unit.size() ||
+		!std::equal(unit.begin(), unit.end(), specs.begin(), [](char const &expected, char const &c)
+					{ return std::tolower(static_cast<unsigned char>(c)) == expected; }))
+	{
+		return;
+	}
+	specs.remove_prefix(unit.size());
+	while (true)
+	{
+		size_t comma = specs.find(',');
+		ByteRange range;
+		if (!parseRangeSpec(RequestParser::trimWhitespace(specs.substr(0, comma)), range))
+		{
+			this->_ranges.clear();
+			return;
+		}
+		this->_ranges.push_back(range);
+		if (comma == std::string_view::npos)
+		{
+			break;
+		}
+		specs.remove_prefix(comma + 1);
+	}
+	std::string_view const *ifRange = head.findHeader("if-range");
+	if (ifRange != nullptr)
+	{
+		this->_ifRange = *ifRange;
+	}
+}
+
+// validators of a cached copy, compared by the response with those of the file
+void Request::parseConditionals(RequestParser const &head)
+{
+	std::string_view const *ifNoneMatch = head.findHeader("if-none-match");
+	if (ifNoneMatch != nullptr)
+	{
+		this->_ifNoneMatch = *ifNoneMatch;
+	}
+	std::string_view const *ifModifiedSince = head.findHeader("if-modified-since");
+	if (ifModifiedSince != nullptr)
+	{
+		this->_ifModifiedSince = *ifModifiedSince;
+	}
+}
+
+// 100-continue is the only expectation there is, an HTTP/1.0 client cannot be sent an interim response
+void Request::parseExpect(RequestParser const &head)
 {
-	auto it = this->_headerLines.find("user-agent");
-	if (it == this->_headerLines.end())
+	std::string_view const *expectValue = head.findHeader("expect");
+	if (expectValue == nullptr || (this->_httpVersionMajor == 1 && this->_httpVersionMinor == 0))
 	{
 		return;
 	}
-	this->_userAgent = it->second;
+	if (!StringUtils::equalsIgnoreCase(*expectValue, "100-continue"))
+	{
+		this->_statusCode = HttpStatusCode::EXPECTATION_FAILED;
+		throw BadRequestException("Unsupported expectation");
+	}
+	this->_expectContinue = this->_bodyExpected;
 }
 
-void Request::parseConnection()
+void Request::parseConnection(RequestParser const &head)
 {
-	auto it = this->_headerLines.find("connection");
-	if (it == this->_headerLines.end())
+	std::string_view const *connectionValue = head.findHeader("connection");
+	if (connectionValue == nullptr)
 	{
 		return;
 	}
-	std::string connectionValue = it->second;
-	std::transform(connectionValue.begin(), connectionValue.end(), connectionValue.begin(), ::tolower);
-	if (connectionValue == "close")
+	if (StringUtils::equalsIgnoreCase(*connectionValue, "close"))
 	{
 		this->_connection = ConnectionValue::CLOSE;
 	}
-	else if (connectionValue != "keep-alive")
+	else if (!StringUtils::equalsIgnoreCase(*connectionValue, "keep-alive"))
 	{
 		throw BadRequestException("Unsupported connection value");
 	}
 }
 
-void Request::parseContentType()
+void Request::parseContentType(RequestParser const &head)
 {
-	auto it = this->_headerLines.find("content-type");
-	if (it == this->_headerLines.end())
+	std::string_view const *contentTypeValue = head.findHeader("content-type");
+	if (contentTypeValue == nullptr)
 	{
 		return;
 	}
-	std::string contentTypeFullValue = it->second;
+	std::string contentTypeFullValue(*contentTypeValue);
 
 	// split by semicolon
 	std::vector<std::string> split = StringUtils::splitByDelimiter(contentTypeFullValue, ";");
@@ -376,64 +591,39 @@ void Request::parseContentType()
 
 // HEADERS GENERAL
 
-void Request::parseHeaders()
-{
-	parseHost();
-	parseContentLength();
-	parseTransferEncoding();
-	parseUserAgent();
-	parseConnection();
-	parseContentType();
-}
-
-void Request::extractHeaderLine(const std::string &headerLine)
+void Request::parseHeaders(RequestParser const &head)
 {
-	std::string forbiddenChars = CR LF NUL;
-	std::regex headerLineRegex("^([^" + forbiddenChars + "]+):" SP "([^" + forbiddenChars + "]+)$");
-	std::smatch match;
-	if (std::regex_match(headerLine, match, headerLineRegex))
-	{
-		std::string fieldName = match[1];
-		std::transform(fieldName.begin(), fieldName.end(), fieldName.begin(), ::tolower);
-		if (this->_headerLines.find(fieldName) != this->_headerLines.end())
-		{
-			throw BadRequestException("Duplicate header field");
-		}
-		this->_headerLines[fieldName] = match[2];
-	}
-	else
-	{
-		throw BadRequestException("Header line extraction error");
-	}
+	parseHost(head);
+	parseContentLength(head);
+	parseTransferEncoding(head);
+	if (this->_bodyExpected)
+		this->_requestBody = RequestBody(this->_config.getBodyBufferSize());
+	parseUserAgent(head);
+	parseConnection(head);
+	parseContentType(head);
+	if (this->_bodyExpected && this->_contentType == ContentType::MULTIPART_FORM_DATA && !targetsCgi()) // a CGI script gets the body as it is
+		this->_multipartParser = std::make_unique<MultipartParser>(this->_boundary, this->_config.getBodyBufferSize());
+	parseAcceptEncoding(head);
+	parseRange(head);
+	parseConditionals(head);
+	parseExpect(head);
 }
 
 // GENERAL
 
-void Request::processRequest(const std::string &requestLineAndHeaders)
+// the head is parsed in one pass, the views of the parser are only used before this returns
+void Request::processRequest(std::string_view const &requestLineAndHeaders)
 {
-	if (requestLineAndHeaders.empty())
-	{
-		throw BadRequestException("Empty request line and headers");
-	}
-	std::vector<std::string> split = StringUtils::splitByDelimiter(requestLineAndHeaders, CRLF);
-	// handle request line
-	if (split.size() < 2)
-	{
-		throw BadRequestException("Less than 2 lines in request line and headers");
-	}
-	extractRequestLine(split[0]);
-	parseRequestLine();
-	// handle headers
-	for (size_t i = 1; i < split.size(); ++i)
-	{
-		extractHeaderLine(split[i]);
-	}
-	parseHeaders();
+	RequestParser head(requestLineAndHeaders);
+	parseRequestLine(head.getRequestLine());
+	parseHeaders(head);
 }
 
-Request::Request(const std::vector<ConfigData> &configs, const std::string &requestLineAndHeaders)
+Request::Request(const std::vector<ConfigData> &configs, std::string_view const &requestLineAndHeaders)
 	: HttpMessage(configs.front()),
 	  _bodyExpected(false),
+	  _expectContinue(false),
+	  _maxBodySize(0),
 	  _port(0),
 	  _configs(configs)
 {
@@ -441,6 +631,11 @@ Request::Request(const std::vector<ConfigData> &configs, const std::string &requ
 	{
 		processRequest(requestLineAndHeaders);
 	}
+	catch (const RequestParser::ParseException &e)
+	{
+		Logger::log(ERROR, SERVER, "ParseException: %s", e.what());
+		this->_statusCode = e.getStatusCode();
+	}
 	catch (const BadRequestException &e)
 	{
 		Logger::log(ERROR, SERVER, "BadRequestException: %s", e.what());
@@ -457,7 +652,7 @@ Request::Request(const std::vector<ConfigData> &configs, const std::string &requ
 }
 
 Request::Request(const std::vector<ConfigData> &configs, HttpStatusCode statusCode)
-	: HttpMessage(configs.front(), statusCode), _bodyExpected(false), _port(0), _configs(configs)
+	: HttpMessage(configs.front(), statusCode), _bodyExpected(false), _expectContinue(false), _maxBodySize(0), _port(0), _configs(configs)
 {
 	// here we can just pick first config, because it doesn't matter for simple error messages
 }
@@ -2,12 +2,18 @@
 #define REQUEST_HPP
 
 #include <string>
+#include <string_view>
 #include <unordered_map>
-#include <regex>
+#include <unordered_set>
 #include <algorithm>
 #include <limits>
+#include <memory>
 
 #include "../HttpMessage/HttpMessage.hpp"
+#include "RequestParser.hpp"
+#include "ChunkedDecoder.hpp"
+#include "RequestBody.hpp"
+#include "MultipartParser.hpp"
 #include "../Utils/StringUtils.hpp"
 #include "../Utils/HttpUtils.hpp"
 #include "../Utils/Logger.hpp"
@@ -15,87 +21,100 @@
 
 class Request : public HttpMessage
 {
-private:
-	// STRUCTS
-
-	struct RequestLine
+public:
+	// one range of "Range: bytes=...", -1 where a number is left out ("-500" is the last 500 bytes)
+	struct ByteRange
 	{
-		std::string method;
-		std::string requestTarget;
-		std::string HTTPVersionMajor;
-		std::string HTTPVersionMinor;
-		/*
-		When a major version of HTTP does not define any minor versions, the minor version "0" is implied. A recipient that receives a message with a major version number that it implements and a minor version number higher than what it implements SHOULD process the message as if it were in the highest minor version within that major version to which the recipient is conformant.
-		*/
-		// What about version 1.0 - do we need to ask to upgrade? probably yes
+		long long first;
+		long long last;
 	};
 
+private:
 	// PROPERTIES
 
-	// Helper properties for initial data read
-	std::unordered_map<std::string, std::string> _headerLines;
-	RequestLine _requestLine;
-
 	// Properties unique to Request
 
 	bool _bodyExpected;
+	bool _expectContinue; // Expect: 100-continue, the client waits for a go-ahead before sending the body
+	size_t _maxBodySize;  // of the matching location, known once a body is announced
 	std::string _userAgent;
 	std::string _host;
 	int _port;
 	std::string _transferEncoding;
 	std::string _charset;
+	std::unordered_set<std::string> _acceptedEncodings; // lowercase, without the ones refused with q=0
+	std::vector<ByteRange> _ranges;
+	std::string _ifRange;
+	std::string _ifNoneMatch;
+	std::string _ifModifiedSince;
 	std::vector<ConfigData> _configs;
-
-	// OPTIONAL: handle Expect header
+	ChunkedDecoder _chunkedDecoder;
+	RequestBody _requestBody; // instead of _body, in memory or spooled to a temporary file
+	std::unique_ptr<MultipartParser> _multipartParser; // a form upload is taken apart as it arrives instead of kept
 
 	// METHODS
 
 	// helpers
 
-	// std::string removeComments(const std::string &input) const;
-	//  initial data reading
-	void extractRequestLine(const std::string &requestLine);
-	void extractHeaderLine(const std::string &headerLine);
 	// parsing
-	int parseMajorVersion();
-	int parseMinorVersion();
-	HttpMethod matchValidMethod();
-	HttpMethod parseMethod();
-	std::string parseTarget();
-	void validateMethod();
+	static int parseDigits(std::string_view const &digits);
+	static bool isZeroQValue(std::string_view const &qValue);
+	static bool parseRangeSpec(std::string_view const &spec, ByteRange &range);
+	int parseMajorVersion(std::string_view const &majorDigits);
+	int parseMinorVersion(std::string_view const &minorDigits);
+	HttpMethod matchValidMethod(std::string_view const &method);
+	HttpMethod parseMethod(std::string_view const &method);
+	void validateMethod(std::string_view const &method);
 
 	void matchConfig();
-	void parseRequestLine();
-	void parseHost();
-	void parseContentLength();
-	void parseTransferEncoding();
-	void parseUserAgent();
-	void parseHeaders();
-	void parseConnection();
-	void parseContentType();
+	size_t matchMaxBodySize();
+	bool targetsCgi() const;
+	BodySink &getBodySink();
+	void parseRequestLine(RequestParser::RequestLine const &requestLine);
+	void parseHost(RequestParser const &head);
+	void parseContentLength(RequestParser const &head);
+	void parseTransferEncoding(RequestParser const &head);
+	void parseUserAgent(RequestParser const &head);
+	void parseHeaders(RequestParser const &head);
+	void parseConnection(RequestParser const &head);
+	void parseContentType(RequestParser const &head);
+	void parseAcceptEncoding(RequestParser const &head);
+	void parseRange(RequestParser const &head);
+	void parseConditionals(RequestParser const &head);
+	void parseExpect(RequestParser const &head);
 
 	// main function
-	void processRequest(const std::string &requestLineAndHeaders);
+	void processRequest(std::string_view const &requestLineAndHeaders);
 
 public:
 	// Request(const ConfigData &config, const std::string &requestLineAndHeaders);
 	// Request(const ConfigData &config, HttpStatusCode statusCode);
-	Request(const std::vector<ConfigData> &configs, const std::string &requestLineAndHeaders); // with configs
+	Request(const std::vector<ConfigData> &configs, std::string_view const &requestLineAndHeaders); // with configs
 	Request(const std::vector<ConfigData> &configs, HttpStatusCode statusCode);				   // with configs
 
 	// SETTERS
 
 	void appendToBody(const std::vector<std::byte> &newBodyChunk);
-	void appendToBody(char newBodyChunk[], const ssize_t &bytes);
-	void resizeBody(const size_t &n);
+	void appendToBody(const char newBodyChunk[], const size_t &bytes);
+	ChunkedDecoder::Status appendChunkedBody(const std::byte data[], const size_t &size, size_t &consumed);
 
 	// GETTERS
 
 	std::string getHost() const;
 	std::string getUserAgent() const;
 	bool isBodyExpected() const;
+	bool expectsContinue() const;
+	size_t getMaxBodySize() const;
+	RequestBody const &getBody() const;
+	MultipartParser const *getMultipartParser() const;
+	size_t getBodySize() const;
 	std::string getTransferEncoding() const;
 	std::string getMethodStr() const;
+	bool acceptsEncoding(const std::string &coding) const;
+	std::vector<ByteRange> const &getRanges() const;
+	std::string getIfRange() const;
+	std::string getIfNoneMatch() const;
+	std::string getIfModifiedSince() const;
 
 	// EXCEPTIONS
 
@@ -0,0 +1,141 @@
+#include "RequestBody.hpp"
+
+RequestBody::RequestBody(size_t const &bufferSize)
+	: spoolFd(-1), size(0), bufferSize(bufferSize), mapping(nullptr), mappingSize(0) {}
+
+RequestBody::RequestBody(RequestBody &&other)
+	: spoolFd(-1), size(0), bufferSize(0), mapping(nullptr), mappingSize(0)
+{
+	*this = std::move(other);
+}
+
+RequestBody &RequestBody::operator=(RequestBody &&other)
+{
+	if (this != &other)
+	{
+		reset();
+		memory = std::move(other.memory);
+		spoolFd = other.spoolFd;
+		size = other.size;
+		bufferSize = other.bufferSize;
+		mapping = other.mapping;
+		mappingSize = other.mappingSize;
+		other.spoolFd = -1;
+		other.size = 0;
+		other.mapping = nullptr;
+		other.mappingSize = 0;
+	}
+	return *this;
+}
+
+RequestBody::~RequestBody()
+{
+	reset();
+}
+
+void RequestBody::reset()
+{
+	unmap();
+	if (spoolFd >= 0)
+		close(spoolFd);
+	spoolFd = -1;
+	memory.clear();
+	size = 0;
+}
+
+// the body grew past the buffer size, what is in memory moves to a new unlinked file
+void RequestBody::spool()
+{
+#ifdef O_TMPFILE
+	spoolFd = open(CLIENT_BODY_TEMP_DIR, O_TMPFILE | O_RDWR | O_CLOEXEC, 0600);
+	if (spoolFd < 0 && errno != EOPNOTSUPP && errno != EISDIR && errno != EINVAL)
+		throw SpoolException("Cannot create the request body temp file");
+#endif
+	if (spoolFd < 0) // no O_TMPFILE on this system or file system
+	{
+		char path[] = CLIENT_BODY_TEMP_DIR "/webserv-body-XXXXXX";
+		spoolFd = mkstemp(path);
+		if (spoolFd < 0)
+			throw SpoolException("Cannot create the request body temp file");
+		unlink(path);
+		fcntl(spoolFd, F_SETFD, FD_CLOEXEC);
+	}
+	writeToSpool(memory.data(), memory.size(), 0);
+	std::vector<std::byte>().swap(memory);
+}
+
+void RequestBody::writeToSpool(const std::byte *data, size_t const &bytes, size_t const &offset)
+{
+	size_t written = 0;
+	while (written < bytes)
+	{
+		ssize_t result = pwrite(spoolFd, data + written, bytes - written, offset + written);
+		if (result < 0 && errno == EINTR)
+			continue;
+		if (result <= 0)
+			throw SpoolException("Cannot write the request body temp file");
+		written += result;
+	}
+}
+
+void RequestBody::unmap() const
+{
+	if (mapping != nullptr)
+		munmap(mapping, mappingSize);
+	mapping = nullptr;
+	mappingSize = 0;
+}
+
+void RequestBody::append(const std::byte *data, size_t const &bytes)
+{
+	if (bytes == 0)
+		return;
+	if (spoolFd < 0 && size + bytes > bufferSize)
+		spool();
+	if (spoolFd >= 0)
+	{
+		unmap();
+		writeToSpool(data, bytes, size);
+	}
+	else
+		memory.insert(memory.end(), data, data + bytes);
+	size += bytes;
+}
+
+/* The whole body as one run of bytes. A spooled body is mapped read-only, its pages come from
+ * the page cache and can be dropped again under memory pressure, unlike a copy in memory.
+ */
+const std::byte *RequestBody::data() const
+{
+	if (spoolFd < 0 || size == 0)
+		return memory.data();
+	if (mapping == nullptr)
+	{
+		void *mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, spoolFd, 0);
+		if (mapped == MAP_FAILED)
+			throw SpoolException("Cannot map the request body temp file");
+		mapping = mapped;
+		mappingSize = size;
+	}
+	return static_cast<const std::byte *>(mapping);
+}
+
+size_t RequestBody::getSize() const
+{
+	return size;
+}
+
+bool RequestBody::empty() const
+{
+	return size == 0;
+}
+
+bool RequestBody::isSpooled() const
+{
+	return spoolFd >= 0;
+}
+
+int const &RequestBody::getSpoolFd() const
+{
+	return spoolFd;
+}
@@ -0,0 +1,72 @@
+#ifndef REQUESTBODY_HPP
+#define REQUESTBODY_HPP
+
+#include <vector>
+#include <string>
+#include <limits>
+#include <utility>
+#include <exception>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "BodySink.hpp"
+#include "../defines.hpp"
+
+/* The body of a request, which is what its readers (the upload handler, the multipart parser, CGI)
+ * get it from. Up to the buffer size it is kept in memory; once it grows past that, it moves to an
+ * unlinked temporary file (O_TMPFILE, or mkstemp() and unlink() where that is not supported) and
+ * the rest is written there as it arrives. The file goes away with its descriptor.
+ * The spool is written with pwrite() only, so its file offset stays at the start and a CGI
+ * script can take the descriptor as its stdin.
+ */
+class RequestBody : public BodySink
+{
+private:
+	std::vector<std::byte> memory;
+	int spoolFd; // -1 while the body is in memory
+	size_t size;
+	size_t bufferSize;
+	mutable void *mapping; // the spool mapped by data(), dropped when the body grows
+	mutable size_t mappingSize;
+
+	RequestBody(const RequestBody &) = delete;
+	RequestBody &operator=(const RequestBody &) = delete;
+
+	void spool();
+	void writeToSpool(const std::byte *data, size_t const &bytes, size_t const &offset);
+	void unmap() const;
+	void reset();
+
+public:
+	RequestBody(size_t const &bufferSize = std::numeric_limits<size_t>::max());
+	RequestBody(RequestBody &&other);
+	RequestBody &operator=(RequestBody &&other);
+	~RequestBody();
+
+	void append(const std::byte *data, size_t const &bytes) override;
+	const std::byte *data() const;
+	size_t getSize() const;
+	bool empty() const;
+	bool isSpooled() const;
+	int const &getSpoolFd() const;
+
+	class SpoolException : public std::exception
+	{
+	private:
+		const char *message;
+
+	public:
+		SpoolException(const char *msg) : message(msg) {}
+		const char *what() const throw() override
+		{
+			return message;
+		}
+	};
+};
+
+#endif
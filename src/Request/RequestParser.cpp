@@ -0,0 +1,174 @@
+#include "RequestParser.hpp"
+
+RequestParser::RequestParser(std::string_view head)
+	: requestLine(), fieldCount(0)
+{
+	if (head.empty())
+	{
+		throw ParseException("Empty request line and headers");
+	}
+	size_t lineEnd = head.find(CRLF);
+	if (lineEnd == std::string_view::npos)
+	{
+		throw ParseException("Less than 2 lines in request line and headers");
+	}
+	parseRequestLine(head.substr(0, lineEnd));
+	size_t lineStart = lineEnd + sizeof(CRLF) - 1;
+	while (lineStart <= head.size())
+	{
+		lineEnd = head.find(CRLF, lineStart);
+		if (lineEnd == std::string_view::npos)
+		{
+			lineEnd = head.size();
+		}
+		parseHeaderLine(head.substr(lineStart, lineEnd - lineStart));
+		lineStart = lineEnd + sizeof(CRLF) - 1;
+	}
+}
+
+// CHARACTER CLASSES
+
+bool RequestParser::isTokenChar(unsigned char const &c)
+{
+	return std::isalnum(c) || (c != '\0' && std::strchr(TOKEN_SPECIAL_CHARS, c) != nullptr);
+}
+
+bool RequestParser::isTargetChar(unsigned char const &c)
+{
+	return std::isalnum(c) || (c != '\0' && std::strchr(TARGET_SPECIAL_CHARS, c) != nullptr);
+}
+
+// VCHAR, obs-text, SP and HTAB
+bool RequestParser::isFieldValueChar(unsigned char const &c)
+{
+	return c == ' ' || c == '\t' || (c > ' ' && c != 0x7f);
+}
+
+// OWS around a field value or a list element
+std::string_view RequestParser::trimWhitespace(std::string_view str)
+{
+	size_t first = str.find_first_not_of(SP HTAB);
+	if (first == std::string_view::npos)
+	{
+		return std::string_view();
+	}
+	return str.substr(first, str.find_last_not_of(SP HTAB) - first + 1);
+}
+
+// REQUEST LINE
+
+// method SP request-target SP HTTP/major.minor, the version numbers have up to 3 digits
+void RequestParser::parseRequestLine(std::string_view line)
+{
+	size_t methodEnd = 0;
+	while (methodEnd < line.size() && isTokenChar(line[methodEnd]))
+	{
+		++methodEnd;
+	}
+	if (methodEnd == 0 || methodEnd == line.size() || line[methodEnd] != ' ')
+	{
+		throw ParseException("Request line extraction error");
+	}
+	this->requestLine.method = line.substr(0, methodEnd);
+	line.remove_prefix(methodEnd + 1);
+
+	size_t targetEnd = 0;
+	while (targetEnd < line.size() && isTargetChar(line[targetEnd]))
+	{
+		++targetEnd;
+	}
+	if (targetEnd == 0 || targetEnd == line.size() || line[targetEnd] != ' ')
+	{
+		throw ParseException("Target parsing error");
+	}
+	this->requestLine.target = line.substr(0, targetEnd);
+	line.remove_prefix(targetEnd + 1);
+
+	if (line.substr(0, 5) != "HTTP/")
+	{
+		throw ParseException("Request line extraction error");
+	}
+	line.remove_prefix(5);
+	this->requestLine.versionMajor = parseVersionNumber(line, 1);
+	if (line.empty() || line[0] != '.')
+	{
+		throw ParseException("Request line extraction error");
+	}
+	line.remove_prefix(1);
+	this->requestLine.versionMinor = parseVersionNumber(line, 0);
+	if (!line.empty())
+	{
+		throw ParseException("Request line extraction error");
+	}
+}
+
+// the digits at the start of line, taken off it
+std::string_view RequestParser::parseVersionNumber(std::string_view &line, size_t const &minDigits)
+{
+	size_t digits = 0;
+	while (digits < line.size() && digits <= 3 && std::isdigit(static_cast<unsigned char>(line[digits])))
+	{
+		++digits;
+	}
+	if (digits < minDigits || digits > 3)
+	{
+		throw ParseException("Request line extraction error");
+	}
+	std::string_view number = line.substr(0, digits);
+	line.remove_prefix(digits);
+	return number;
+}
+
+// HEADERS
+
+// field-name ":" OWS field-value OWS
+void RequestParser::parseHeaderLine(std::string_view line)
+{
+	size_t nameEnd = 0;
+	while (nameEnd < line.size() && isTokenChar(line[nameEnd]))
+	{
+		++nameEnd;
+	}
+	if (nameEnd == 0 || nameEnd == line.size() || line[nameEnd] != ':')
+	{
+		throw ParseException("Header line extraction error");
+	}
+	std::string_view name = line.substr(0, nameEnd);
+	std::string_view value = trimWhitespace(line.substr(nameEnd + 1));
+	for (char c : value)
+	{
+		if (!isFieldValueChar(c))
+		{
+			throw ParseException("Invalid character in header field value");
+		}
+	}
+	if (findHeader(name) != nullptr)
+	{
+		throw ParseException("Duplicate header field");
+	}
+	if (this->fieldCount == this->fields.size())
+	{
+		throw ParseException("Too many header fields", HttpStatusCode::REQUEST_HEADER_FIELDS_TOO_LARGE);
+	}
+	this->fields[this->fieldCount++] = {name, value};
+}
+
+// GETTERS
+
+RequestParser::RequestLine const &RequestParser::getRequestLine() const
+{
+	return this->requestLine;
+}
+
+// the value of a header field, names compare case-insensitively, nullptr if it was not sent
+std::string_view const *RequestParser::findHeader(std::string_view const &name) const
+{
+	for (size_t i = 0; i < this->fieldCount; ++i)
+	{
+		if (StringUtils::equalsIgnoreCase(this->fields[i].name, name))
+		{
+			return &this->fields[i].value;
+		}
+	}
+	return nullptr;
+}
@@ -0,0 +1,75 @@
+#ifndef REQUESTPARSER_HPP
+#define REQUESTPARSER_HPP
+
+#include <string>
+#include <string_view>
+#include <array>
+#include <cstring>
+#include <cctype>
+#include <exception>
+
+#include "../Utils/StringUtils.hpp"
+#include "../defines.hpp"
+
+/* Request line and header fields of a request head (everything before the empty line), parsed in
+ * one pass over the raw text. Every part is a view into that text and the fields live in a fixed
+ * array, so parsing allocates nothing: the views are only valid as long as the head they came from.
+ * Syntax follows RFC 9112: the method and field names are tokens, a field name is directly followed
+ * by ':', field values are visible characters, spaces and tabs with the surrounding whitespace left
+ * out, and lines end with CRLF. Obsolete line folding is rejected.
+ */
+class RequestParser
+{
+public:
+	struct RequestLine
+	{
+		std::string_view method;
+		std::string_view target;
+		std::string_view versionMajor;
+		std::string_view versionMinor; // empty for "HTTP/1."
+	};
+
+	struct HeaderField
+	{
+		std::string_view name;
+		std::string_view value;
+	};
+
+private:
+	RequestLine requestLine;
+	std::array<HeaderField, MAX_HEADER_FIELDS> fields;
+	size_t fieldCount;
+
+	void parseRequestLine(std::string_view line);
+	void parseHeaderLine(std::string_view line);
+	static std::string_view parseVersionNumber(std::string_view &line, size_t const &minDigits);
+
+public:
+	RequestParser(std::string_view head);
+
+	RequestLine const &getRequestLine() const;
+	std::string_view const *findHeader(std::string_view const &name) const;
+
+	static bool isTokenChar(unsigned char const &c);
+	static bool isTargetChar(unsigned char const &c);
+	static bool isFieldValueChar(unsigned char const &c);
+	static std::string_view trimWhitespace(std::string_view str);
+
+	class ParseException : public std::exception
+	{
+	private:
+		const char *message;
+		HttpStatusCode statusCode;
+
+	public:
+		ParseException(const char *msg, HttpStatusCode statusCode = HttpStatusCode::BAD_REQUEST)
+			: message(msg), statusCode(statusCode) {}
+		HttpStatusCode getStatusCode() const { return statusCode; }
+		const char *what() const throw() override
+		{
+			return message;
+		}
+	};
+};
+
+#endif
@@ -27,16 +27,21 @@ void Response::printResponseProperties() const
 	std::cout << "Method: " << HttpUtils::_httpMethodToStr.at(this->_method) << std::endl;
 	std::cout << "HTTP version: " << this->_httpVersionMajor << "." << this->_httpVersionMinor << std::endl;
 	std::cout << "Boundary: " << this->_boundary << std::endl;
-	std::cout << "Parts size: " << this->_parts.size() << std::endl;
 }
 
 // STRING FORMING FUNCTIONS
 
 std::string Response::formatDate() const
 {
-	std::time_t currentTime = std::chrono::system_clock::to_time_t(this->_date);
+	return formatHttpDate(std::chrono::system_clock::to_time_t(this->_date));
+}
+
+std::string Response::formatHttpDate(std::time_t const &time)
+{
+	std::tm gmTime;
+	gmtime_r(&time, &gmTime);
 	std::stringstream ss;
-	ss << std::put_time(std::gmtime(&currentTime), "%a, %d %b %Y %H:%M:%S GMT");
+	ss << std::put_time(&gmTime, "%a, %d %b %Y %H:%M:%S GMT");
 	std::string httpDate = ss.str();
 	return httpDate;
 }
@@ -95,11 +100,42 @@ std::string Response::formatHeader() const
 	header += this->formatStatusLine() + CRLF;
 	header += "Date: " + this->formatDate() + CRLF;
 	header += "Server: " SERVER_SOFTWARE CRLF;
-	header += "Content-Length: " + std::to_string(this->_contentLength) + CRLF;
+	if (this->_statusCode != HttpStatusCode::NOT_MODIFIED) // a 304 has no body, and must not announce another one
+	{
+		header += "Content-Length: " + std::to_string(this->_contentLength) + CRLF;
+	}
 	if (!this->_upgradeHeader.empty())
 	{
 		header += "Upgrade: " + this->_upgradeHeader + CRLF;
 	}
+	if (!this->_contentEncodingHeader.empty())
+	{
+		header += "Content-Encoding: " + this->_contentEncodingHeader + CRLF;
+	}
+	if (!this->_varyHeader.empty())
+	{
+		header += "Vary: " + this->_varyHeader + CRLF;
+	}
+	if (!this->_contentTypeHeader.empty())
+	{
+		header += "Content-Type: " + this->_contentTypeHeader + CRLF;
+	}
+	if (!this->_lastModifiedHeader.empty())
+	{
+		header += "Last-Modified: " + this->_lastModifiedHeader + CRLF;
+	}
+	if (!this->_etagHeader.empty())
+	{
+		header += "ETag: " + this->_etagHeader + CRLF;
+	}
+	if (!this->_contentRangeHeader.empty())
+	{
+		header += "Content-Range: " + this->_contentRangeHeader + CRLF;
+	}
+	else if (this->_bodyFile || this->_bodyBuffer)
+	{
+		header += "Accept-Ranges: bytes" CRLF;
+	}
 	header += "Connection: " + this->formatConnection() + CRLF;
 	if (!this->_locationHeader.empty())
 	{
@@ -109,28 +145,67 @@ std::string Response::formatHeader() const
 	return header;
 }
 
-std::vector<std::byte> Response::formatResponse() const
+// status line and headers, or the whole response on a critical error
+std::string Response::formatResponseHead() const
 {
-	std::vector<std::byte> response;
 	if (this->_criticalError)
-	{
-		std::string errorMessage = CRITICAL_ERROR_RESPONSE;
-		for (char ch : errorMessage)
-		{
-			response.push_back(static_cast<std::byte>(ch));
-		}
-	}
-	else
-	{
-		std::string formattedHeader = this->formatHeader();
-		for (char ch : formattedHeader)
-		{
-			response.push_back(static_cast<std::byte>(ch));
-		}
-		std::vector<std::byte> body = this->_body;
-		response.insert(response.end(), body.begin(), body.end());
-	}
-	return response;
+		return CRITICAL_ERROR_RESPONSE;
+	return this->formatHeader();
+}
+
+// the body is handed over to the output queue instead of being copied
+std::vector<std::byte> Response::takeBody()
+{
+	if (this->_criticalError)
+		return std::vector<std::byte>();
+	return std::move(this->_body);
+}
+
+std::shared_ptr<OpenFile> Response::takeBodyFile()
+{
+	if (this->_criticalError)
+		return nullptr;
+	return std::move(this->_bodyFile);
+}
+
+ContentCache::Buffer Response::takeBodyBuffer()
+{
+	if (this->_criticalError)
+		return nullptr;
+	return std::move(this->_bodyBuffer);
+}
+
+std::vector<Response::BodyRange> Response::takeBodyRanges()
+{
+	if (this->_criticalError)
+		return std::vector<BodyRange>();
+	return std::move(this->_bodyRanges);
+}
+
+std::string const &Response::getBodyRangesTail() const
+{
+	return this->_bodyRangesTail;
+}
+
+bool Response::isBodyFileZeroCopy()
+{
+	return this->_location.getSendFile();
+}
+
+size_t Response::getBodySize() const
+{
+	if (!this->_bodyRanges.empty())
+	{
+		size_t size = this->_bodyRangesTail.size();
+		for (BodyRange const &range : this->_bodyRanges)
+			size += range.head.size() + range.length;
+		return size;
+	}
+	if (this->_bodyFile)
+		return this->_bodyFile->getSize();
+	if (this->_bodyBuffer)
+		return this->_bodyBuffer->size();
+	return this->_body.size();
 }
 
 // RESPONSE PREPARATION
@@ -163,6 +238,15 @@ void Response::prepareErrorResponse()
 {
 	prepareStandardHeaders();
 	Logger::log(DEBUG, SERVER, "getting error page for status code: %d", this->_statusCode);
+	this->_bodyFile.reset();
+	this->_bodyBuffer.reset();
+	this->_contentEncodingHeader.clear();
+	this->_varyHeader.clear();
+	this->_lastModifiedHeader.clear();
+	this->_etagHeader.clear();
+	this->_contentTypeHeader.clear();
+	this->_bodyRanges.clear();
+	this->_bodyRangesTail.clear();
 	try
 	{
 		if (!getConfiguredErrorPage())
@@ -217,7 +301,8 @@ bool Response::targetFound()
 {
 	std::string fullPathNotTrimmed = StringUtils::joinPath(this->_actualLocationPath, this->_pathAfterLocation, this->_fileName);
 	std::string fullPath = StringUtils::trimChar(fullPathNotTrimmed, '/');
-	if (!FileSystemUtils::pathExists(fullPath))
+	this->_targetInfo = OpenFileCache::getInstance().lookup(fullPath);
+	if (this->_targetInfo.error != 0)
 	{
 		Logger::log(DEBUG, SERVER, "Target %s not found", fullPath.c_str());
 		this->_statusCode = HttpStatusCode::NOT_FOUND;
@@ -347,7 +432,7 @@ void Response::executeCGI()
 	}
 }
 
-void Response::postMultipartDataPart(const MultipartDataPart &part)
+void Response::postMultipartDataPart(const MultipartParser::Part &part)
 {
 	auto it = part.headers.find("content-disposition");
 	if (it == part.headers.end())
@@ -400,8 +485,13 @@ void Response::postMultipartDataPart(const MultipartDataPart &part)
 	// TODO: fgure out the root/alias situation
 	std::string savePath = StringUtils::joinPath(this->_actualLocationPath, this->_pathAfterLocation, this->_location.getSaveDir());
 	Logger::log(DEBUG, SERVER, "Saving file to: %s", savePath.c_str());
-	// save the file
-	FileSystemUtils::saveFile(savePath, fileName, part.body);
+	// save the file, a spooled part is given its name instead of being written again
+	if (part.body.isSpooled())
+		FileSystemUtils::saveFile(savePath, fileName, part.body.getSpoolFd(), part.body.getSize());
+	else
+		FileSystemUtils::saveFile(savePath, fileName, part.body.data(), part.body.getSize());
+	OpenFileCache::getInstance().invalidate(StringUtils::joinPath(savePath, fileName));
+	ContentCache::getInstance().invalidate(StringUtils::joinPath(savePath, fileName));
 }
 
 void Response::handlePost()
@@ -409,11 +499,17 @@ void Response::handlePost()
 	// if it's not multipart form, just return back the data sent by client
 	if (this->_request.getContentType() != ContentType::MULTIPART_FORM_DATA)
 	{
-		this->_body = this->_request.getBody();
+		RequestBody const &requestBody = this->_request.getBody();
+		if (requestBody.isSpooled()) // sent back from its temp file instead of being read into memory
+			this->_bodyFile = std::make_shared<OpenFile>(requestBody.getSpoolFd());
+		else
+			this->_body.assign(requestBody.data(), requestBody.data() + requestBody.getSize());
 		this->_contentType = this->_request.getContentType();
 		this->_statusCode = HttpStatusCode::CREATED;
 		return;
 	}
+	// the parts were received already, the body has to be complete
+	processMultipartData();
 	// check if upload is allowed
 	if (this->_location.getSaveDirIsEmpty())
 	{
@@ -421,9 +517,9 @@ void Response::handlePost()
 		throw ClientException("Upload not allowed, no save_dir specified in location");
 	}
 	// iterate throu parts and save them to files
-	for (size_t i = 0; i < this->_parts.size(); i++)
+	for (const MultipartParser::Part &part : this->_request.getMultipartParser()->getParts())
 	{
-		postMultipartDataPart(this->_parts[i]);
+		postMultipartDataPart(part);
 	}
 	// set the Location header to contain path to the uploads directory
 	this->_locationHeader = '/' + this->_location.getSaveDir();
@@ -437,7 +533,7 @@ void Response::handleGet()
 	std::string path = StringUtils::joinPath(this->_actualLocationPath, this->_pathAfterLocation, this->_fileName);
 	std::string userPath = StringUtils::joinPath(this->_locationPath, this->_pathAfterLocation);
 
-	if (FileSystemUtils::isDir(path))
+	if (this->_targetInfo.isDir)
 	{
 		std::string dirPath = StringUtils::trimChar(path, '/');
 		Logger::log(DEBUG, SERVER, "GET directory: %s", path.c_str());
@@ -452,9 +548,13 @@ void Response::handleGet()
 		{
 			// check if this should be target or some location property
 			Logger::log(DEBUG, SERVER, "Serving index file: %s", this->_location.getDefaultFile().c_str());
-			this->_body = BinaryData::getFileData(StringUtils::joinPath(dirPath, this->_location.getDefaultFile()));
-			this->_statusCode = HttpStatusCode::OK;
+			std::string indexPath = StringUtils::joinPath(dirPath, this->_location.getDefaultFile());
 			this->_contentType = ContentType::TEXT_HTML;
+			OpenFileCache::FileInfo indexFile = OpenFileCache::getInstance().lookup(indexPath);
+			if (notModified(indexFile))
+				return;
+			setFileBody(indexFile, indexPath);
+			this->_statusCode = HttpStatusCode::OK;
 		}
 		else
 		{
@@ -464,10 +564,14 @@ void Response::handleGet()
 	}
 	else
 	{
-		if (FileSystemUtils::isFile(path))
+		if (this->_targetInfo.isFile)
 		{
 			Logger::log(DEBUG, SERVER, "Serving file: %s", path.c_str());
-			this->_body = BinaryData::getFileData(path);
+			auto type = HttpUtils::_extensionContentTypes.find(this->_fileExtension);
+			this->_contentType = (type != HttpUtils::_extensionContentTypes.end() ? type->second : ContentType::APPLICATION_OCTET_STREAM);
+			if (notModified(this->_targetInfo))
+				return;
+			setFileBody(this->_targetInfo, path);
 			this->_statusCode = HttpStatusCode::OK;
 		}
 		else
@@ -478,12 +582,205 @@ void Response::handleGet()
 	}
 }
 
+void Response::setFileBody(OpenFileCache::FileInfo const &file, std::string const &path)
+{
+	if (this->_location.getGzipStatic())
+	{
+		// the body depends on Accept-Encoding, whichever file is sent
+		this->_varyHeader = "Accept-Encoding";
+		if (setPrecompressedFileBody(path))
+			return;
+	}
+	attachFileBody(OpenFileCache::getInstance().open(file, path), path, true);
+}
+
+/* Validators of the file from its stat() data, so that a 304 is answered without opening it.
+ * The ETag is weak where the body may be encoded (gzip, gzip_static), the encoded bytes differ from
+ * the file's. If-None-Match wins over If-Modified-Since, and is compared weakly (RFC 9110 13.1.2).
+ */
+bool Response::notModified(OpenFileCache::FileInfo const &file)
+{
+	if (file.error != 0 || !file.isFile)
+		return false;
+	std::stringstream etag;
+	etag << std::hex << '"' << file.inode << '-' << file.lastModified << '-' << file.size << '"';
+	bool mayBeEncoded = this->_location.getGzip() || this->_location.getGzipStatic();
+	this->_etagHeader = (mayBeEncoded ? "W/" : "") + etag.str();
+	this->_lastModifiedHeader = formatHttpDate(file.lastModified);
+	if (mayBeEncoded)
+		this->_varyHeader = "Accept-Encoding";
+
+	bool notModified = false;
+	std::string ifNoneMatch = this->_request.getIfNoneMatch();
+	std::string ifModifiedSince = this->_request.getIfModifiedSince();
+	if (!ifNoneMatch.empty())
+	{
+		for (std::string const &tag : StringUtils::splitByDelimiter(ifNoneMatch, ","))
+		{
+			std::string opaqueTag = StringUtils::trim(tag);
+			if (opaqueTag.compare(0, 2, "W/") == 0)
+				opaqueTag = opaqueTag.substr(2);
+			if (opaqueTag == "*" || opaqueTag == etag.str())
+				notModified = true;
+		}
+	}
+	else if (!ifModifiedSince.empty())
+	{
+		std::tm since = {};
+		if (strptime(ifModifiedSince.c_str(), "%a, %d %b %Y %H:%M:%S GMT", &since) != nullptr)
+			notModified = (file.lastModified <= timegm(&since));
+	}
+	if (notModified)
+	{
+		Logger::log(DEBUG, SERVER, "Not modified: %s", this->_etagHeader.c_str());
+		this->_statusCode = HttpStatusCode::NOT_MODIFIED;
+		this->_body.clear();
+	}
+	return notModified;
+}
+
+// a sibling compressed ahead of time, looked up like the target itself so a hit costs no syscall
+bool Response::setPrecompressedFileBody(std::string const &path)
+{
+	static const std::pair<std::string, std::string> precompressed[] = {{"br", ".br"}, {"gzip", ".gz"}};
+	for (std::pair<std::string, std::string> const &encoding : precompressed)
+	{
+		if (!this->_request.acceptsEncoding(encoding.first))
+			continue;
+		std::string siblingPath = path + encoding.second;
+		OpenFileCache::FileInfo sibling = OpenFileCache::getInstance().lookup(siblingPath);
+		if (!sibling.isFile)
+			continue;
+		std::shared_ptr<OpenFile> file;
+		try
+		{
+			file = OpenFileCache::getInstance().open(sibling, siblingPath);
+		}
+		catch (const std::runtime_error &e)
+		{
+			continue;
+		}
+		Logger::log(DEBUG, SERVER, "Serving precompressed file: %s", siblingPath.c_str());
+		attachFileBody(file, siblingPath, false);
+		this->_contentEncodingHeader = encoding.first;
+		return true;
+	}
+	return false;
+}
+
+/* The file is already open (and maybe cached). A small file comes from the content cache, gzipped
+ * there once if the location wants it, a bigger one is sent (or streamed window by window) from the
+ * file when the response goes out.
+ */
+void Response::attachFileBody(std::shared_ptr<OpenFile> const &file, std::string const &path, bool const &compressible)
+{
+	if (compressible && shouldGzip(file->getSize()))
+	{
+		this->_bodyBuffer = ContentCache::getInstance().getGzipped(path, *file);
+		if (this->_bodyBuffer)
+		{
+			this->_contentEncodingHeader = "gzip";
+			this->_body.clear();
+			return;
+		}
+	}
+	this->_bodyBuffer = ContentCache::getInstance().get(path, *file);
+	if (!this->_bodyBuffer)
+		this->_bodyFile = file;
+	this->_body.clear();
+}
+
+// whether a body of this size and of the current content type goes out gzipped, Vary is set either way
+bool Response::shouldGzip(size_t const &bodySize)
+{
+	if (!this->_location.getGzip() || !this->_contentEncodingHeader.empty() || bodySize < this->_location.getGzipMinLength() ||
+		this->_location.getGzipTypes().count(this->_contentType) == 0)
+		return false;
+	this->_varyHeader = "Accept-Encoding";
+	return this->_request.acceptsEncoding("gzip");
+}
+
+// bodies built in memory (directory listing, CGI output, echoed POST), compressed per response
+void Response::gzipMemoryBody()
+{
+	if (this->_bodyFile || this->_bodyBuffer || this->_body.empty() || !shouldGzip(this->_body.size()))
+		return;
+	try
+	{
+		this->_body = Compression::gzip(this->_body);
+		this->_contentEncodingHeader = "gzip";
+	}
+	catch (const std::runtime_error &e)
+	{
+		Logger::log(ERROR, SERVER, "Sending the body uncompressed: %s", e.what());
+	}
+}
+
+/* Byte ranges of a body that comes from a file (plain, precompressed or gzipped once), for GET only.
+ * Ranges past the end are dropped, 416 if none is left. One range is sent as it is, several as
+ * multipart/byteranges. If-Range only lets the ranges through while it names the Last-Modified
+ * date the file still has, otherwise the whole file is sent.
+ */
+void Response::applyRanges()
+{
+	std::vector<Request::ByteRange> const &requested = this->_request.getRanges();
+	if (requested.empty() || this->_method != HttpMethod::GET || this->_statusCode != HttpStatusCode::OK ||
+		(!this->_bodyFile && !this->_bodyBuffer) || requested.size() > MAX_BYTE_RANGES)
+		return;
+	std::string ifRange = this->_request.getIfRange();
+	if (!ifRange.empty() && ifRange != this->_lastModifiedHeader && (ifRange != this->_etagHeader || ifRange.compare(0, 2, "W/") == 0))
+		return; // only a strong ETag or the exact date lets the ranges through
+	long long size = getBodySize();
+	std::vector<BodyRange> ranges;
+	for (Request::ByteRange const &range : requested)
+	{
+		long long first = range.first;
+		long long last = (range.last < 0 || range.last >= size) ? size - 1 : range.last;
+		if (first < 0) // suffix, last is the number of bytes
+		{
+			first = size - std::min(range.last, size);
+			last = size - 1;
+		}
+		if (first >= size || (range.first < 0 && range.last == 0))
+			continue;
+		ranges.push_back({"", static_cast<off_t>(first), static_cast<size_t>(last - first + 1)});
+	}
+	if (ranges.empty())
+	{
+		this->_contentRangeHeader = "bytes */" + std::to_string(size);
+		this->_statusCode = HttpStatusCode::RANGE_NOT_SATISFIABLE;
+		throw ClientException("Range not satisfiable");
+	}
+	this->_statusCode = HttpStatusCode::PARTIAL_CONTENT;
+	if (ranges.size() == 1)
+	{
+		BodyRange const &range = ranges.front();
+		this->_contentRangeHeader = "bytes " + std::to_string(range.offset) + "-" + std::to_string(range.offset + range.length - 1) + "/" + std::to_string(size);
+		this->_bodyRanges = ranges;
+		return;
+	}
+	std::stringstream boundary;
+	boundary << "webserv" << std::hex << std::chrono::steady_clock::now().time_since_epoch().count();
+	for (BodyRange &range : ranges)
+	{
+		range.head = CRLF "--" + boundary.str() + CRLF "Content-Type: " + formatContentType() + CRLF "Content-Range: bytes " +
+					 std::to_string(range.offset) + "-" + std::to_string(range.offset + range.length - 1) + "/" + std::to_string(size) + CRLF CRLF;
+	}
+	this->_bodyRangesTail = CRLF "--" + boundary.str() + "--" CRLF;
+	this->_contentTypeHeader = "multipart/byteranges; boundary=" + boundary.str();
+	this->_bodyRanges = ranges;
+}
+
+// the same headers as GET, the encoding included, only the body is not sent
 void Response::handleHead()
 {
 	handleGet();
-	this->_contentLength = this->_body.size();
+	gzipMemoryBody();
+	this->_contentLength = getBodySize();
 	Logger::log(DEBUG, SERVER, "Set HEAD content length: %d", this->_contentLength);
 	this->_body.clear();
+	this->_bodyFile.reset();
+	this->_bodyBuffer.reset();
 }
 
 void Response::handleDelete()
@@ -511,6 +808,8 @@ void Response::handleDelete()
 	else
 	{
 		FileSystemUtils::deleteFile(path);
+		OpenFileCache::getInstance().invalidate(path);
+		ContentCache::getInstance().invalidate(path);
 		this->_statusCode = HttpStatusCode::NO_CONTENT;
 		this->_body = BinaryData::strToVectorByte("File deleted successfully");
 		this->_contentType = ContentType::TEXT_PLAIN;
@@ -532,129 +831,27 @@ void Response::handleRootAndAlias()
 	}
 }
 
-void Response::processMultipartDataPartHeaders(MultipartDataPart &dataPart, std::string headersString)
-{
-	std::stringstream partStream(headersString);
-	std::string line;
-	while (std::getline(partStream, line))
-	{
-		if (!StringUtils::trim(line).empty())
-		{
-			size_t pos = line.find(':');
-			if (pos != std::string::npos)
-			{
-				std::string headerName = StringUtils::trim(line.substr(0, pos));
-				std::transform(headerName.begin(), headerName.end(), headerName.begin(), ::tolower);
-				std::string headerValue = StringUtils::trim(line.substr(pos + 1));
-				dataPart.headers[headerName] = headerValue;
-			}
-		}
-	}
-}
-
-void Response::processMultipartDataPart(std::vector<std::byte> part)
-{
-	std::cout << "\nprocessMultipartDataPart():" << std::endl;
-	for (auto ch : part)
-	{
-		std::cout << static_cast<char>(ch);
-	}
-	MultipartDataPart dataPart;
-
-	// fnd the end of headers and process them, they can be processed as a string
-	std::string partString(reinterpret_cast<const char *>(part.data()), part.size());
-	auto crlfPos = partString.find(CRLF CRLF);
-	if (crlfPos == std::string::npos)
-	{
-		throw ClientException("No CRLF CRLF found in multipart data part to separte headers");
-	}
-	// substring until the first CRLF CRLF
-	std::string headersString = partString.substr(0, crlfPos);
-	processMultipartDataPartHeaders(dataPart, headersString);
-
-	// the rest is the body, it needs to be processed as binary
-	dataPart.body = std::vector<std::byte>(part.begin() + crlfPos + 4, part.end());
-
-	this->_parts.push_back(dataPart);
-}
-
+// the body was taken apart while it was received, only the outcome is checked here
 void Response::processMultipartData()
 {
-	if (this->_request.getContentType() != ContentType::MULTIPART_FORM_DATA)
+	MultipartParser const *parser = this->_request.getMultipartParser();
+	if (parser == nullptr)
 	{
-		return;
-	}
-	std::vector<std::byte> requestBody = this->_request.getBody();
-	const std::vector<std::byte> &messageBody = this->_request.getBody();
-	const std::string delimiter = "--" + this->_boundary;
-	const std::string endDelimiter = delimiter + "--";
-	// convert delimiters to byte vectors for direct memory comparison
-	std::vector<std::byte> delimiterBytes;
-	delimiterBytes.reserve(delimiter.size());
-	for (char ch : delimiter)
-	{
-		delimiterBytes.push_back(static_cast<std::byte>(ch));
+		throw ClientException("No multipart data");
 	}
-	std::vector<std::byte> endDelimiterBytes;
-	endDelimiterBytes.reserve(endDelimiter.size());
-	for (char ch : endDelimiter)
+	if (parser->getStatus() == MultipartParser::MULTIPART_BAD_SYNTAX)
 	{
-		endDelimiterBytes.push_back(static_cast<std::byte>(ch));
+		throw ClientException("Invalid multipart data format");
 	}
-	// find the start of the first part
-	auto partStart = std::search(messageBody.begin(), messageBody.end(), delimiterBytes.begin(), delimiterBytes.end());
-	if (partStart == messageBody.end())
-	{
-		throw ClientException("First boundary not found in multipart data");
-	}
-
-	// Skip the delimiter
-	partStart += delimiterBytes.size();
-
-	// find endDelimiter
-
-	auto endDelimiterIt = std::search(partStart, messageBody.end(), endDelimiterBytes.begin(), endDelimiterBytes.end());
-	if (endDelimiterIt == messageBody.end())
+	if (parser->getStatus() != MultipartParser::MULTIPART_COMPLETE)
 	{
 		throw ClientException("End boundary not found in multipart data");
 	}
-
-	while (partStart != messageBody.end())
-	{
-		// Find the end of the current part
-		auto partEnd = std::search(partStart, messageBody.end(), delimiterBytes.begin(), delimiterBytes.end());
-		// TODO: finish the whole crlf condition thing
-		if (partEnd == messageBody.end() || partEnd - partStart < 4)
-		{
-			throw ClientException("Invalid multipart data format, no next delimiter found or too short part");
-		}
-		// Extract the current part
-		std::vector<std::byte> part(partStart + 2, partEnd - 2);
-		processMultipartDataPart(part);
-		// if this was the last part, stop
-		if (partEnd == endDelimiterIt)
-		{
-			break;
-		}
-		// If not the end, move to the start of the next part
-		partStart = partEnd + delimiterBytes.size();
-	}
-	Logger::log(DEBUG, SERVER, "Processed multipart data, parts detected: %d", this->_parts.size());
-	if (this->_parts.size() == 0)
+	Logger::log(DEBUG, SERVER, "Processed multipart data, parts detected: %d", parser->getParts().size());
+	if (parser->getParts().size() == 0)
 	{
 		throw ClientException("No parts found in multipart data");
 	}
-	/* std::cout << "Parsed parts:" << std::endl;
-	for (auto &part : this->_parts)
-	{
-		for (auto &[key, value] : part.headers)
-		{
-			std::cout << key << ": " << value << std::endl;
-		}
-		std::cout << "Body:" << std::endl;
-		for (auto ch : part.body)
-			std::cout << static_cast<char>(ch);
-	} */
 }
 
 bool Response::methodAllowed()
@@ -669,7 +866,7 @@ bool Response::methodAllowed()
 
 void Response::prepareResponse()
 {
-	if (this->_request.getBody().size() > this->_config.getMaxClientBodySize())
+	if (this->_request.getBodySize() > this->_request.getMaxBodySize())
 	{
 		this->_statusCode = HttpStatusCode::PAYLOAD_TOO_LARGE;
 	}
@@ -678,15 +875,6 @@ void Response::prepareResponse()
 	{
 		throw ServerException("Error status code already set, skipping response preparation");
 	}
-	// Process multipart form if it exists
-	try
-	{
-		processMultipartData();
-	}
-	catch (const std::exception &e)
-	{
-		throw ClientException("Error processing multipart data");
-	}
 	// Prepare headers that are standard for every response
 	prepareStandardHeaders();
 
@@ -748,6 +936,7 @@ void Response::prepareResponse()
 			break;
 		case HttpMethod::GET:
 			handleGet();
+			applyRanges();
 			break;
 		case HttpMethod::HEAD:
 			handleHead();
@@ -763,7 +952,8 @@ void Response::prepareResponse()
 	// Set content length
 	if (this->_method != HttpMethod::HEAD)
 	{
-		this->_contentLength = this->_body.size();
+		gzipMemoryBody();
+		this->_contentLength = getBodySize();
 	}
 }
 
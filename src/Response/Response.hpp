@@ -13,6 +13,10 @@
 #include "../Utils/StringUtils.hpp"
 #include "../Utils/FileSystemUtils.hpp"
 #include "../Utils/BinaryData.hpp"
+#include "../Utils/OpenFile.hpp"
+#include "../Utils/OpenFileCache.hpp"
+#include "../Utils/ContentCache.hpp"
+#include "../Utils/Compression.hpp"
 #include "../Utils/HttpUtils.hpp"
 #include "../Utils/Logger.hpp"
 #include "../Config/Location.hpp"
@@ -25,18 +29,31 @@ class HttpMessage;
 
 class Response : public HttpMessage
 {
-private:
-	struct MultipartDataPart
+public:
+	// one range of the body to send, with the part header in front of it for multipart/byteranges
+	struct BodyRange
 	{
-		std::map<std::string, std::string> headers;
-		std::vector<std::byte> body;
+		std::string head;
+		off_t offset;
+		size_t length;
 	};
 
+private:
 	std::string _serverHeader;
 	std::string _locationHeader;
 	std::string _upgradeHeader;
-
-	std::vector<MultipartDataPart> _parts;
+	std::string _contentEncodingHeader;
+	std::string _varyHeader;
+	std::string _lastModifiedHeader;
+	std::string _etagHeader;
+	std::string _contentRangeHeader;
+	std::string _contentTypeHeader; // only sent for multipart/byteranges so far
+
+	std::shared_ptr<OpenFile> _bodyFile; // body sent straight from the file instead of _body
+	ContentCache::Buffer _bodyBuffer;	 // cached file content shared with other responses, instead of _body
+	std::vector<BodyRange> _bodyRanges; // parts of _bodyFile or _bodyBuffer sent for a Range request
+	std::string _bodyRangesTail;		 // closing boundary of multipart/byteranges
+	OpenFileCache::FileInfo _targetInfo; // what targetFound() learned about the target path
 	Request const &_request;
 	Location _location;
 	std::string _redirectionRoute;
@@ -50,6 +67,7 @@ private:
 
 	bool extractFileNameAndQuery(const std::string &fileName);
 	std::string formatDate() const;
+	static std::string formatHttpDate(std::time_t const &time);
 	std::string formatStatusLine() const;
 	std::string formatHeader() const;
 	std::string formatStatusCodeMessage() const;
@@ -64,9 +82,7 @@ private:
 	void prepareStandardHeaders();
 	void prepareRedirectResponse();
 	void processMultipartData();
-	void processMultipartDataPart(std::vector<std::byte> part);
-	void postMultipartDataPart(const MultipartDataPart &part);
-	void processMultipartDataPartHeaders(MultipartDataPart &dataPart, std::string headersString);
+	void postMultipartDataPart(const MultipartParser::Part &part);
 	bool isRedirect(); // consts?
 	void handleRootAndAlias();
 	bool targetFound();
@@ -74,6 +90,14 @@ private:
 	void executeCGI();
 	void handlePost();
 	void handleGet();
+	void setFileBody(OpenFileCache::FileInfo const &file, std::string const &path);
+	bool setPrecompressedFileBody(std::string const &path);
+	bool notModified(OpenFileCache::FileInfo const &file);
+	void attachFileBody(std::shared_ptr<OpenFile> const &file, std::string const &path, bool const &compressible);
+	bool shouldGzip(size_t const &bodySize);
+	void gzipMemoryBody();
+	void applyRanges();
+	size_t getBodySize() const;
 	void handleHead();
 	void handleDelete();
 	void prepareResponse();
@@ -81,7 +105,13 @@ private:
 public:
 	Response(const Request &request);
 
-	std::vector<std::byte> formatResponse() const;
+	std::string formatResponseHead() const;
+	std::vector<std::byte> takeBody();
+	std::shared_ptr<OpenFile> takeBodyFile();
+	ContentCache::Buffer takeBodyBuffer();
+	std::vector<BodyRange> takeBodyRanges();
+	std::string const &getBodyRangesTail() const;
+	bool isBodyFileZeroCopy();
 	void printResponseProperties() const;
 
 	class ClientException : public std::exception
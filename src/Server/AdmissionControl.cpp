@@ -0,0 +1,87 @@
+#include "AdmissionControl.hpp"
+
+ConnectionLimiter::ConnectionLimiter(size_t const &limit) : active(0), limit(limit)
+{
+}
+
+bool ConnectionLimiter::tryAcquire()
+{
+	size_t count = active.fetch_add(1, std::memory_order_relaxed);
+	if (limit != 0 && count >= limit)
+	{
+		active.fetch_sub(1, std::memory_order_relaxed);
+		return (false);
+	}
+	return (true);
+}
+
+void ConnectionLimiter::release()
+{
+	active.fetch_sub(1, std::memory_order_relaxed);
+}
+
+size_t ConnectionLimiter::getActive() const
+{
+	return (active.load(std::memory_order_relaxed));
+}
+
+/* A connection is admitted before its Host header is known, so the limit belongs to the listening
+ * address: it is the max_connections set by any of its server blocks (the parser rejects different values).
+ */
+AdmissionControl::AdmissionControl(GlobalConfig const &globalConfig, std::vector<ConfigData> const &serverConfigs)
+	: globalLimiter(globalConfig.getMaxConnections())
+{
+	std::map<std::string, size_t> limits;
+	for (const ConfigData &config : serverConfigs)
+	{
+		size_t &limit = limits[toListenerKey(config.getServerHost(), config.getServerPort())];
+		if (limit == 0)
+			limit = config.getMaxConnections();
+	}
+	for (std::pair<const std::string, size_t> const &limit : limits)
+		listenerLimiters[limit.first] = std::make_unique<ConnectionLimiter>(limit.second);
+	serviceUnavailableResponse = "HTTP/1.1 503 Service Unavailable" CRLF
+								 "Server: " SERVER_SOFTWARE CRLF
+								 "Retry-After: " + std::to_string(SHED_RETRY_AFTER_SECONDS) + CRLF
+								 "Content-Length: 0" CRLF
+								 "Connection: close" CRLF CRLF;
+}
+
+std::string AdmissionControl::toListenerKey(std::string const &host, int const &port)
+{
+	return (host + ":" + std::to_string(port));
+}
+
+ConnectionLimiter &AdmissionControl::getListenerLimiter(std::string const &host, int const &port)
+{
+	return (*listenerLimiters.at(toListenerKey(host, port)));
+}
+
+bool AdmissionControl::admit(ConnectionLimiter &listenerLimiter)
+{
+	if (!globalLimiter.tryAcquire())
+		return (false);
+	if (!listenerLimiter.tryAcquire())
+	{
+		globalLimiter.release();
+		return (false);
+	}
+	return (true);
+}
+
+void AdmissionControl::release(ConnectionLimiter &listenerLimiter)
+{
+	listenerLimiter.release();
+	globalLimiter.release();
+}
+
+// one non-blocking send of the prebuilt response, the connection is closed by the caller whatever happens
+void AdmissionControl::shed(int const &clientFd) const
+{
+	send(clientFd, serviceUnavailableResponse.data(), serviceUnavailableResponse.size(), MSG_DONTWAIT);
+}
+
+size_t AdmissionControl::getActiveConnections() const
+{
+	return (globalLimiter.getActive());
+}
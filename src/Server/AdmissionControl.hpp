@@ -0,0 +1,55 @@
+#ifndef ADMISSIONCONTROL_HPP
+#define ADMISSIONCONTROL_HPP
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <sys/socket.h>
+
+#include "../Config/ConfigParser.hpp"
+#include "../defines.hpp"
+
+// a shared count of open connections with an optional upper bound, safe to use from every worker thread
+class ConnectionLimiter
+{
+private:
+	std::atomic<size_t> active;
+	size_t limit; // 0 for no limit
+
+public:
+	ConnectionLimiter(size_t const &limit);
+
+	bool tryAcquire();
+	void release();
+	size_t getActive() const;
+};
+
+/* Admission control of the whole process: one limiter for all connections and one per listening address,
+ * created before the workers start and shared by all of them. A connection over a limit is shed with a
+ * prebuilt 503, so the clients already admitted keep their latency.
+ */
+class AdmissionControl
+{
+private:
+	ConnectionLimiter globalLimiter;
+	std::map<std::string, std::unique_ptr<ConnectionLimiter>> listenerLimiters; // keyed by host:port
+	std::string serviceUnavailableResponse;
+
+	static std::string toListenerKey(std::string const &host, int const &port);
+
+	AdmissionControl(const AdmissionControl &) = delete;
+	AdmissionControl &operator=(const AdmissionControl &) = delete;
+
+public:
+	AdmissionControl(GlobalConfig const &globalConfig, std::vector<ConfigData> const &serverConfigs);
+
+	ConnectionLimiter &getListenerLimiter(std::string const &host, int const &port);
+	bool admit(ConnectionLimiter &listenerLimiter);
+	void release(ConnectionLimiter &listenerLimiter);
+	void shed(int const &clientFd) const;
+	size_t getActiveConnections() const;
+};
+
+#endif
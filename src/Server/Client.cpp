@@ -1,19 +1,18 @@
 #include "Client.hpp"
 
-Client::Client(sockaddr_in clientAddress)
-		: address(clientAddress), request(nullptr), response(nullptr), isConnectionClose(false),
-			bytesSent(0), chunkSize(0), bytesToReceive(0)
+Client::Client(int const &clientFd, sockaddr_in clientAddress)
+		: fd(clientFd), address(clientAddress), request(nullptr), response(nullptr), isConnectionClose(false),
+			headerScanned(0)
 {
 }
 
-void Client::createRequest(std::string const &requestHeader, std::vector<ConfigData> const &configs)
+// the head is parsed in place from the input buffer, then consumed with its empty line
+void Client::createRequest(size_t const &headerLength, std::vector<ConfigData> const &configs)
 {
 	removeRequest();
-	request = std::make_unique<Request>(configs, requestHeader); // Create a Request object with the provided header
-	bytesSent = 0;
-	chunkSize = 0;
-	bytesToReceive = 0;
-	bodyBuf.clear();
+	request = std::make_unique<Request>(configs, std::string_view(inputBuffer.peek(), headerLength)); // Create a Request object with the provided header
+	inputBuffer.consume(headerLength + sizeof(CRLF CRLF) - 1);
+	headerScanned = 0;
 }
 
 void Client::createErrorRequest(std::vector<ConfigData> const &configs, HttpStatusCode statusCode)
@@ -21,13 +20,33 @@ void Client::createErrorRequest(std::vector<ConfigData> const &configs, HttpStat
 	removeRequest();
 	Logger::log(ERROR, SERVER, "Creating error request with status code: %d ", statusCode);
 	request = std::make_unique<Request>(configs, statusCode); // Create a Request object with the provided header
+	inputBuffer.consume(inputBuffer.size()); // nothing after an unreadable request can be trusted
+	headerScanned = 0;
 }
 
 void Client::createResponse()
 {
 	removeResponse();
 	response = std::make_unique<Response>(*request); // Create a Response object with the corresponding request
-	bytesSent = 0;
+	outputQueue.clear();
+	outputQueue.append(response->formatResponseHead()); // serialized once, sent from the queue
+	outputQueue.append(response->takeBody());
+	ContentCache::Buffer bodyBuffer = response->takeBodyBuffer();
+	std::shared_ptr<OpenFile> bodyFile = response->takeBodyFile();
+	std::vector<Response::BodyRange> ranges = response->takeBodyRanges();
+	if (bodyFile)
+		outputQueue.setWindowSize(response->getConfig().getStreamWindowSize());
+	if (ranges.empty() && (bodyBuffer || bodyFile))
+		ranges.push_back({"", 0, bodyBuffer ? bodyBuffer->size() : static_cast<size_t>(bodyFile->getSize())});
+	for (Response::BodyRange const &range : ranges)
+	{
+		outputQueue.append(range.head);
+		if (bodyBuffer)
+			outputQueue.append(bodyBuffer, range.offset, range.length);
+		else if (bodyFile)
+			outputQueue.appendFile(bodyFile, range.offset, range.length, response->isBodyFileZeroCopy());
+	}
+	outputQueue.append(response->getBodyRangesTail());
 }
 
 void Client::removeRequest()
@@ -45,6 +64,12 @@ bool Client::isNewRequest() const
 	return (request ? false : true);
 }
 
+// false while the request is still being received, its output queue may only hold a 100 Continue then
+bool Client::hasResponse() const
+{
+	return (response ? true : false);
+}
+
 const Request &Client::getRequest() const
 {
 	return (*request);
@@ -55,6 +80,11 @@ const Response &Client::getResponse() const
 	return (*response);
 }
 
+int const &Client::getFd() const
+{
+	return (fd);
+}
+
 bool const &Client::getIsConnectionClose() const
 {
 	return (isConnectionClose);
@@ -70,24 +100,14 @@ in_addr const &Client::getIPv4Address() const
 	return (address.sin_addr);
 }
 
-size_t const &Client::getBytesSent() const
-{
-	return (bytesSent);
-}
-
-size_t Client::getChunkSize() const
-{
-	return (chunkSize);
-}
-
-std::vector<std::byte> Client::getBodyBuf() const
+OutputQueue &Client::getOutputQueue()
 {
-	return (bodyBuf);
+	return (outputQueue);
 }
 
-size_t Client::getBytesToReceive() const
+InputBuffer &Client::getInputBuffer()
 {
-	return (bytesToReceive);
+	return (inputBuffer);
 }
 
 void Client::setIsConnectionClose(bool const &status)
@@ -95,40 +115,20 @@ void Client::setIsConnectionClose(bool const &status)
 	isConnectionClose = status;
 }
 
-void Client::setBytesSent(size_t const &bytes)
+// only the bytes added since the last search are scanned, from 3 bytes earlier for an empty line split between two reads
+size_t Client::findHeaderDelimiter()
 {
-	bytesSent = bytes;
+	size_t overlap = sizeof(CRLF CRLF) - 2;
+	size_t from = headerScanned > overlap ? headerScanned - overlap : 0;
+	size_t delimiterPos = ByteScanner::find(inputBuffer.peek() + from, inputBuffer.size() - from, CRLF CRLF, sizeof(CRLF CRLF) - 1);
+	headerScanned = inputBuffer.size();
+	return (delimiterPos == ByteScanner::npos ? std::string::npos : from + delimiterPos);
 }
 
-void Client::setChunkSize(const size_t &bytes)
+// bytes of a pipelined request that arrived with the previous one and were not searched yet
+bool Client::hasUnscannedInput() const
 {
-	chunkSize = bytes;
-}
-
-void Client::setBytesToReceive(size_t bytes)
-{
-	bytesToReceive = bytes;
-}
-
-void Client::appendToBodyBuf(const std::vector<std::byte> &buf)
-{
-	bodyBuf.insert(bodyBuf.end(), buf.begin(), buf.end());
-}
-
-void Client::appendToBodyBuf(char buf[], const ssize_t &bytes)
-{
-	for (ssize_t i = 0; i < bytes; ++i)
-		bodyBuf.push_back(static_cast<std::byte>(buf[i]));
-}
-
-void Client::eraseBodyBuf(const size_t &start, const size_t &end)
-{
-	bodyBuf.erase(bodyBuf.begin() + start, bodyBuf.begin() + end);
-}
-
-void Client::clearBodyBuf()
-{
-	bodyBuf.clear();
+	return (headerScanned < inputBuffer.size());
 }
 
 void Client::appendToRequestBody(const std::vector<std::byte> &newBodyChunk)
@@ -137,19 +137,16 @@ void Client::appendToRequestBody(const std::vector<std::byte> &newBodyChunk)
 		request->appendToBody(newBodyChunk);
 }
 
-void Client::appendToRequestBody(char newBodyChunk[], const ssize_t &bytes)
+void Client::appendToRequestBody(const char newBodyChunk[], const size_t &bytes)
 {
 	if (request)
 		request->appendToBody(newBodyChunk, bytes);
 }
 
-void Client::resizeRequestBody(const size_t &n)
-{
-	if (request)
-		request->resizeBody(n);
-}
-
-std::vector<std::byte> Client::getRequestBody() const
+ChunkedDecoder::Status Client::appendChunkedToRequestBody(const std::byte data[], const size_t &size, size_t &consumed)
 {
-	return (request->getBody());
+	consumed = 0;
+	if (!request)
+		return (ChunkedDecoder::CHUNKED_BAD_SYNTAX);
+	return (request->appendChunkedBody(data, size, consumed));
 }
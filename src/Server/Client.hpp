@@ -9,30 +9,33 @@
 #include "../Request/Request.hpp"
 #include "../Response/Response.hpp"
 #include "../Config/ConfigData.hpp"
+#include "OutputQueue.hpp"
+#include "InputBuffer.hpp"
+#include "../Utils/ByteScanner.hpp"
 
 class Client
 {
 
 private:
+	int fd;
 	struct sockaddr_in address;
 	std::unique_ptr<Request> request;
 	std::unique_ptr<Response> response;
 	bool isConnectionClose;
 
 	// Helper properties for sending
-	size_t bytesSent;
+	OutputQueue outputQueue;
 
 	// Helper properties for parsing
-	size_t chunkSize;
-	std::vector<std::byte> bodyBuf;
-	size_t bytesToReceive;
+	InputBuffer inputBuffer; // received bytes not parsed yet: the head read so far, body bytes, a pipelined request
+	size_t headerScanned;	 // bytes of inputBuffer already searched for the empty line after the head
 
 	Client();
 
 public:
-	Client(struct sockaddr_in clientAddress);
+	Client(int const &clientFd, struct sockaddr_in clientAddress);
 
-	void createRequest(std::string const &requestHeader, std::vector<ConfigData> const &configs);
+	void createRequest(size_t const &headerLength, std::vector<ConfigData> const &configs);
 	void createErrorRequest(std::vector<ConfigData> const &configs, HttpStatusCode statusCode);
 	void createResponse();
 
@@ -40,31 +43,25 @@ public:
 	void removeResponse();
 
 	bool isNewRequest() const;
+	bool hasResponse() const;
 
 	const Request &getRequest() const;
 	const Response &getResponse() const;
+	int const &getFd() const;
 	bool const &getIsConnectionClose() const;
 	unsigned short int const &getPortNumber() const;
 	struct in_addr const &getIPv4Address() const;
-	size_t const &getBytesSent() const;
-	size_t getChunkSize() const;
-	std::vector<std::byte> getBodyBuf() const;
-	size_t getBytesToReceive() const;
+	OutputQueue &getOutputQueue();
+	InputBuffer &getInputBuffer();
 
 	void setIsConnectionClose(bool const &status);
-	void setBytesSent(size_t const &bytes);
-	void setChunkSize(const size_t &bytes);
-	void setBytesToReceive(size_t bytes);
 
-	void appendToBodyBuf(const std::vector<std::byte> &buf);
-	void appendToBodyBuf(char buf[], const ssize_t &bytes);
-	void eraseBodyBuf(const size_t &start, const size_t &end);
-	void clearBodyBuf();
+	size_t findHeaderDelimiter();
+	bool hasUnscannedInput() const;
 
 	void appendToRequestBody(const std::vector<std::byte> &newBodyChunk);
-	void appendToRequestBody(char newBodyChunk[], const ssize_t &bytes);
-	void resizeRequestBody(const size_t &n);
-	std::vector<std::byte> getRequestBody() const;
+	void appendToRequestBody(const char newBodyChunk[], const size_t &bytes);
+	ChunkedDecoder::Status appendChunkedToRequestBody(const std::byte data[], const size_t &size, size_t &consumed);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include "ConnectionTable.hpp"
+
+ConnectionTable::ConnectionTable() : clientCount(0)
+{
+	rlimit limit = {};
+	size_t capacity = MAX_CONNECTION_TABLE_SIZE;
+	if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY)
+		capacity = std::min(capacity, static_cast<size_t>(limit.rlim_cur));
+	slots.resize(capacity);
+}
+
+bool ConnectionTable::addListener(int const &fd, Server &server)
+{
+	if (fd < 0 || static_cast<size_t>(fd) >= slots.size())
+		return (false);
+	slots[fd].type = LISTENER_SLOT;
+	slots[fd].server = &server;
+	return (true);
+}
+
+// nullptr if the fd does not fit in the table (RLIMIT_NOFILE raised after start up), the caller keeps the client then
+ConnectionTable::Connection *ConnectionTable::addClient(Server &server, std::unique_ptr<Client> &client)
+{
+	int fd = client->getFd();
+	if (fd < 0 || static_cast<size_t>(fd) >= slots.size())
+		return (nullptr);
+	Connection &connection = slots[fd];
+	connection.type = CLIENT_SLOT;
+	connection.server = &server;
+	connection.client = std::move(client);
+	connection.timeout = CLIENT_HEADER_TIMEOUT;
+	++clientCount;
+	return (&connection);
+}
+
+// nullptr for an fd that is not watched (anymore)
+ConnectionTable::Connection *ConnectionTable::find(int const &fd)
+{
+	if (fd < 0 || static_cast<size_t>(fd) >= slots.size() || slots[fd].type == FREE_SLOT)
+		return (nullptr);
+	return (&slots[fd]);
+}
+
+// the timer of the slot has to be cancelled by the caller before
+void ConnectionTable::release(int const &fd)
+{
+	Connection *connection = find(fd);
+	if (connection == nullptr)
+		return;
+	if (connection->type == CLIENT_SLOT)
+		--clientCount;
+	connection->type = FREE_SLOT;
+	connection->server = nullptr;
+	connection->client.reset();
+	++connection->generation;
+}
+
+std::vector<int> ConnectionTable::getClientFds() const
+{
+	std::vector<int> clientFds;
+	for (size_t fd = 0; fd < slots.size() && clientFds.size() < clientCount; ++fd)
+	{
+		if (slots[fd].type == CLIENT_SLOT)
+			clientFds.push_back(fd);
+	}
+	return (clientFds);
+}
+
+size_t ConnectionTable::getClientCount() const
+{
+	return (clientCount);
+}
+
+size_t ConnectionTable::getCapacity() const
+{
+	return (slots.size());
+}
@@ -0,0 +1,59 @@
+#ifndef CONNECTIONTABLE_HPP
+#define CONNECTIONTABLE_HPP
+
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <cstdint>
+#include <sys/resource.h>
+
+#include "Server.hpp"
+#include "Client.hpp"
+#include "TimerWheel.hpp"
+#include "../defines.hpp"
+
+/* Everything a worker knows about a watched fd, indexed by the fd itself, so an event costs one array access.
+ * The kernel hands out the lowest free fd, which keeps the table dense. It is allocated once at the size of
+ * RLIMIT_NOFILE and never grows, because the slots hold timer handles that must not move.
+ */
+class ConnectionTable
+{
+public:
+	enum SlotType
+	{
+		FREE_SLOT,
+		LISTENER_SLOT,
+		CLIENT_SLOT
+	};
+
+	struct Connection
+	{
+		SlotType type = FREE_SLOT;
+		Server *server = nullptr; // the listening Server, or the one that accepted the client
+		std::unique_ptr<Client> client;
+		TimerWheel::TimerHandle timer;
+		ClientTimeout timeout = CLIENT_HEADER_TIMEOUT;
+		uint32_t generation = 0; // bumped when the slot is released, so the events of a former owner of the fd are dropped
+	};
+
+private:
+	std::vector<Connection> slots;
+	size_t clientCount;
+
+	ConnectionTable(const ConnectionTable &) = delete;
+	ConnectionTable &operator=(const ConnectionTable &) = delete;
+
+public:
+	ConnectionTable();
+
+	bool addListener(int const &fd, Server &server);
+	Connection *addClient(Server &server, std::unique_ptr<Client> &client);
+	Connection *find(int const &fd);
+	void release(int const &fd);
+
+	std::vector<int> getClientFds() const;
+	size_t getClientCount() const;
+	size_t getCapacity() const;
+};
+
+#endif
@@ -0,0 +1,79 @@
+#include "EpollBackend.hpp"
+
+#ifdef __linux__
+
+EpollBackend::EpollBackend() : epollFd(-1), readyEvents(EPOLL_MAX_EVENTS)
+{
+	if ((epollFd = epoll_create1(EPOLL_CLOEXEC)) < 0)
+		throw BackendException("EpollBackend::Fail to create epoll instance");
+}
+
+EpollBackend::~EpollBackend()
+{
+	if (epollFd >= 0)
+		close(epollFd);
+}
+
+uint32_t EpollBackend::interestToEvents(Interest const &interest)
+{
+	return (interest == WANT_READ ? EPOLLIN : EPOLLOUT);
+}
+
+// the generation rides along in the upper half of the event data
+uint64_t EpollBackend::toEventData(int const &fd, uint32_t const &generation)
+{
+	return ((static_cast<uint64_t>(generation) << 32) | static_cast<uint32_t>(fd));
+}
+
+void EpollBackend::addFd(int const &fd, Interest const &interest, uint32_t const &generation)
+{
+	epoll_event event = {};
+	event.events = interestToEvents(interest);
+	event.data.u64 = toEventData(fd, generation);
+	if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) < 0)
+		throw BackendException("EpollBackend::Fail to add fd");
+}
+
+void EpollBackend::modifyFd(int const &fd, Interest const &interest, uint32_t const &generation)
+{
+	epoll_event event = {};
+	event.events = interestToEvents(interest);
+	event.data.u64 = toEventData(fd, generation);
+	if (epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event) < 0)
+		throw BackendException("EpollBackend::Fail to modify fd");
+}
+
+// a closed fd is dropped from the interest list by the kernel, so a failure here is not an error
+void EpollBackend::removeFd(int const &fd)
+{
+	epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+}
+
+int EpollBackend::waitForEvents(int const &timeoutMs)
+{
+	events.clear();
+	int ready = epoll_wait(epollFd, readyEvents.data(), readyEvents.size(), timeoutMs);
+	for (int i = 0; i < ready; ++i)
+	{
+		uint32_t flags = readyEvents[i].events;
+		events.push_back({static_cast<int>(readyEvents[i].data.u64 & UINT32_MAX),
+						  static_cast<uint32_t>(readyEvents[i].data.u64 >> 32),
+						  (flags & EPOLLIN) != 0,
+						  (flags & EPOLLOUT) != 0,
+						  (flags & (EPOLLHUP | EPOLLRDHUP)) != 0,
+						  (flags & EPOLLERR) != 0});
+	}
+	return (ready);
+}
+
+std::vector<EventBackend::Event> const &EpollBackend::getEvents() const
+{
+	return (events);
+}
+
+const char *EpollBackend::getName() const
+{
+	return ("epoll");
+}
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef EPOLLBACKEND_HPP
+#define EPOLLBACKEND_HPP
+
+#ifdef __linux__
+
+#include <vector>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include "EventBackend.hpp"
+#include "../defines.hpp"
+
+// epoll() based engine: interest is registered once in the kernel and only ready fds are returned
+class EpollBackend : public EventBackend
+{
+private:
+	int epollFd;
+	std::vector<epoll_event> readyEvents;
+	std::vector<Event> events;
+
+	static uint32_t interestToEvents(Interest const &interest);
+	static uint64_t toEventData(int const &fd, uint32_t const &generation);
+
+	EpollBackend(const EpollBackend &) = delete;
+	EpollBackend &operator=(const EpollBackend &) = delete;
+
+public:
+	EpollBackend();
+	~EpollBackend();
+
+	void addFd(int const &fd, Interest const &interest, uint32_t const &generation) override;
+	void modifyFd(int const &fd, Interest const &interest, uint32_t const &generation) override;
+	void removeFd(int const &fd) override;
+	int waitForEvents(int const &timeoutMs) override;
+	std::vector<Event> const &getEvents() const override;
+	const char *getName() const override;
+};
+
+#endif
+
+#endif
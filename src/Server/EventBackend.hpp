@@ -0,0 +1,55 @@
+#ifndef EVENTBACKEND_HPP
+#define EVENTBACKEND_HPP
+
+#include <vector>
+#include <stdexcept>
+#include <cstdint>
+
+/* Common interface of the readiness notification engines (poll, epoll) used by the server loop.
+ * A fd is registered once with the interest it currently has and the backend only reports fds that are ready.
+ * Every event carries the generation the fd was registered with, so an event that was already reported
+ * for a closed fd is told apart from one for the next connection that got the same fd.
+ */
+class EventBackend
+{
+public:
+	enum Interest
+	{
+		WANT_READ,
+		WANT_WRITE
+	};
+
+	struct Event
+	{
+		int fd;
+		uint32_t generation;
+		bool readable;
+		bool writable;
+		bool hangup;
+		bool error;
+	};
+
+	virtual ~EventBackend() = default;
+
+	virtual void addFd(int const &fd, Interest const &interest, uint32_t const &generation) = 0;
+	virtual void modifyFd(int const &fd, Interest const &interest, uint32_t const &generation) = 0;
+	virtual void removeFd(int const &fd) = 0;
+	virtual int waitForEvents(int const &timeoutMs) = 0; // returns the number of ready fds, -1 on error
+	virtual std::vector<Event> const &getEvents() const = 0;
+	virtual const char *getName() const = 0;
+
+	class BackendException : public std::exception
+	{
+	private:
+		const char *message;
+
+	public:
+		BackendException(const char *msg) : message(msg) {}
+		const char *what() const throw() override
+		{
+			return message;
+		}
+	};
+};
+
+#endif
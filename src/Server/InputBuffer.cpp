@@ -0,0 +1,109 @@
+#include "InputBuffer.hpp"
+
+InputBuffer::InputBuffer()
+	: block(nullptr), capacity(0), start(0), end(0) {}
+
+InputBuffer::~InputBuffer()
+{
+	start = end;
+	release();
+}
+
+// at least INPUT_BUFFER_MIN_READ bytes of free space at the end
+void InputBuffer::makeRoom()
+{
+	if (!block)
+	{
+		block = InputBufferPool::getInstance().acquire();
+		capacity = INPUT_BUFFER_BLOCK_SIZE;
+	}
+	if (capacity - end >= INPUT_BUFFER_MIN_READ)
+		return;
+	size_t unconsumed = end - start;
+	if (start > 0)
+	{
+		std::memmove(block.get(), block.get() + start, unconsumed);
+		start = 0;
+		end = unconsumed;
+	}
+	if (capacity - end >= INPUT_BUFFER_MIN_READ)
+		return;
+	// a request head bigger than the block, it has to stay in one piece for the parser
+	std::unique_ptr<char[]> grown(new char[capacity * 2]);
+	std::memcpy(grown.get(), block.get(), end);
+	if (capacity == INPUT_BUFFER_BLOCK_SIZE)
+		InputBufferPool::getInstance().giveBack(std::move(block));
+	block = std::move(grown);
+	capacity *= 2;
+}
+
+// one recv() into the free space, returns what recv() returned
+ssize_t InputBuffer::receiveFrom(int const &fd)
+{
+	makeRoom();
+	ssize_t bytes = recv(fd, block.get() + end, capacity - end, 0);
+	if (bytes > 0)
+		end += bytes;
+	return (bytes);
+}
+
+const char *InputBuffer::peek() const
+{
+	return (block ? block.get() + start : nullptr);
+}
+
+size_t InputBuffer::size() const
+{
+	return (end - start);
+}
+
+bool InputBuffer::empty() const
+{
+	return (start == end);
+}
+
+void InputBuffer::consume(size_t const &bytes)
+{
+	start += std::min(bytes, size());
+	if (start == end)
+		start = end = 0;
+}
+
+// the block goes back to the pool (a grown one is freed), only when nothing is left to parse
+void InputBuffer::release()
+{
+	if (!block || !empty())
+		return;
+	if (capacity == INPUT_BUFFER_BLOCK_SIZE)
+		InputBufferPool::getInstance().giveBack(std::move(block));
+	block.reset();
+	capacity = 0;
+	start = end = 0;
+}
+
+InputBufferPool &InputBufferPool::getInstance()
+{
+	static thread_local InputBufferPool pool;
+	return (pool);
+}
+
+std::unique_ptr<char[]> InputBufferPool::acquire()
+{
+	if (freeBlocks.empty())
+		return (std::unique_ptr<char[]>(new char[INPUT_BUFFER_BLOCK_SIZE]));
+	std::unique_ptr<char[]> block = std::move(freeBlocks.back());
+	freeBlocks.pop_back();
+	return (block);
+}
+
+// kept for the next connection unless the pool is full
+void InputBufferPool::giveBack(std::unique_ptr<char[]> block)
+{
+	if (freeBlocks.size() < INPUT_BUFFER_POOL_SIZE)
+		freeBlocks.push_back(std::move(block));
+}
+
+size_t InputBufferPool::size() const
+{
+	return (freeBlocks.size());
+}
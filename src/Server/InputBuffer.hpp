@@ -0,0 +1,64 @@
+#ifndef INPUTBUFFER_HPP
+#define INPUTBUFFER_HPP
+
+#include <vector>
+#include <memory>
+#include <cstring>
+#include <cstddef>
+#include <algorithm>
+#include <sys/types.h>
+#include <sys/socket.h>
+
+#include "../defines.hpp"
+
+/* Bytes received from a client and not parsed yet. recv() writes straight into the free space at
+ * the end, the parser peeks at the unconsumed bytes as one contiguous run and consumes what it
+ * used from the front, which only moves an offset. The unconsumed rest is moved back to the start
+ * when the free space runs low, and the block only grows while a request head does not fit.
+ * The standard-size block comes from the worker's pool and goes back to it once everything was
+ * consumed and the connection is idle, so waiting keep-alive connections hold no buffer.
+ */
+class InputBuffer
+{
+private:
+	std::unique_ptr<char[]> block;
+	size_t capacity;
+	size_t start; // block[start, end) is received but not consumed
+	size_t end;
+
+	InputBuffer(const InputBuffer &) = delete;
+	InputBuffer &operator=(const InputBuffer &) = delete;
+
+	void makeRoom();
+
+public:
+	InputBuffer();
+	~InputBuffer();
+
+	ssize_t receiveFrom(int const &fd);
+	const char *peek() const;
+	size_t size() const;
+	bool empty() const;
+	void consume(size_t const &bytes);
+	void release();
+};
+
+// the free standard-size blocks of one worker thread
+class InputBufferPool
+{
+private:
+	std::vector<std::unique_ptr<char[]>> freeBlocks;
+
+	InputBufferPool() = default;
+	InputBufferPool(const InputBufferPool &) = delete;
+	InputBufferPool &operator=(const InputBufferPool &) = delete;
+
+public:
+	static InputBufferPool &getInstance(); // the pool of the calling thread
+
+	std::unique_ptr<char[]> acquire();
+	void giveBack(std::unique_ptr<char[]> block);
+	size_t size() const;
+};
+
+#endif
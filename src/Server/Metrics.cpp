@@ -0,0 +1,25 @@
+#include "Metrics.hpp"
+
+Metrics::Metrics()
+	: acceptWakeUps(0), acceptedConnections(0), maxAcceptsPerWakeUp(0), acceptQueueDrained(0),
+	  acceptBudgetExhausted(0), acceptErrors(0), acceptPauses(0), shedConnections(0), openConnections(0)
+{
+}
+
+void Metrics::recordAcceptWakeUp(size_t const &accepted)
+{
+	++acceptWakeUps;
+	acceptedConnections += accepted;
+	if (accepted > maxAcceptsPerWakeUp)
+		maxAcceptsPerWakeUp = accepted;
+}
+
+void Metrics::log(int const &workerId) const
+{
+	Logger::log(e_log_level::INFO, SERVER, "Worker %d: accepted %zu connections in %zu wakeups (max %zu per wakeup), "
+										   "queue drained %zu, budget exhausted %zu, accept errors %zu, accept pauses %zu, "
+										   "shed %zu, open %zu",
+				workerId, acceptedConnections, acceptWakeUps, maxAcceptsPerWakeUp,
+				acceptQueueDrained, acceptBudgetExhausted, acceptErrors, acceptPauses,
+				shedConnections, openConnections);
+}
@@ -0,0 +1,28 @@
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include <cstddef>
+
+#include "../Utils/Logger.hpp"
+
+// counters of one worker, only touched by the worker's own thread, logged on SIGUSR1 and when it stops
+class Metrics
+{
+public:
+	size_t acceptWakeUps;		  // readiness events on a listening socket
+	size_t acceptedConnections;
+	size_t maxAcceptsPerWakeUp;
+	size_t acceptQueueDrained;	  // wakeups that ended on EAGAIN
+	size_t acceptBudgetExhausted; // wakeups that ended with connections possibly left in the queue
+	size_t acceptErrors;
+	size_t acceptPauses;	// times the process ran out of fds and stopped accepting
+	size_t shedConnections; // closed with a 503 because of max_connections
+	size_t openConnections; // clients of this worker right now
+
+	Metrics();
+
+	void recordAcceptWakeUp(size_t const &accepted);
+	void log(int const &workerId) const;
+};
+
+#endif
@@ -0,0 +1,198 @@
+#include "OutputQueue.hpp"
+
+OutputQueue::OutputQueue()
+	: frontOffset(0), bytesQueued(0), windowSize(DEFAULT_STREAM_WINDOW_SIZE), windowStart(0), windowEnd(0)
+{
+}
+
+void OutputQueue::append(std::string const &data)
+{
+	if (data.empty())
+		return;
+	const std::byte *bytes = reinterpret_cast<const std::byte *>(data.data());
+	segments.push_back({std::make_shared<const std::vector<std::byte>>(bytes, bytes + data.size()), 0, data.size(), nullptr, 0, 0, false});
+	bytesQueued += data.size();
+}
+
+void OutputQueue::append(std::vector<std::byte> &&data)
+{
+	if (data.empty())
+		return;
+	bytesQueued += data.size();
+	size_t length = data.size();
+	segments.push_back({std::make_shared<const std::vector<std::byte>>(std::move(data)), 0, length, nullptr, 0, 0, false});
+}
+
+void OutputQueue::append(std::shared_ptr<const std::vector<std::byte>> const &data)
+{
+	if (data)
+		append(data, 0, data->size());
+}
+
+// part of a shared buffer, e.g. one byte range of a cached file
+void OutputQueue::append(std::shared_ptr<const std::vector<std::byte>> const &data, size_t const &start, size_t const &length)
+{
+	if (length == 0)
+		return;
+	bytesQueued += length;
+	segments.push_back({data, start, length, nullptr, 0, 0, false});
+}
+
+void OutputQueue::appendFile(std::shared_ptr<OpenFile> const &file, off_t const &offset, size_t const &length, bool const &zeroCopy)
+{
+	if (length == 0)
+		return;
+	bytesQueued += length;
+	segments.push_back({nullptr, 0, 0, file, offset, length, zeroCopy});
+}
+
+// size of the window a streamed file goes through
+void OutputQueue::setWindowSize(size_t const &size)
+{
+	windowSize = size;
+}
+
+/* Send until the queue is empty, the socket buffer is full or the budget of one writable event is used up.
+ * Returns the bytes sent, or what the first failing call returned if nothing was sent.
+ */
+ssize_t OutputQueue::sendTo(int const &fd)
+{
+	ssize_t total = 0;
+	while (!segments.empty() && total < OUTPUT_QUEUE_SEND_BUDGET)
+	{
+		size_t attempted = 0;
+		ssize_t bytes = segments.front().file ? sendFileSegment(fd, attempted) : sendMemorySegments(fd, attempted);
+		if (bytes <= 0)
+			return (total > 0 ? total : bytes);
+		total += bytes;
+		if (static_cast<size_t>(bytes) < attempted) // the socket buffer is full
+			break;
+	}
+	return (total);
+}
+
+// one writev() over the memory segments in front of the next file segment
+ssize_t OutputQueue::sendMemorySegments(int const &fd, size_t &attempted)
+{
+	iovec iov[OUTPUT_QUEUE_MAX_IOV];
+	int iovCount = 0;
+	for (std::deque<Segment>::iterator it = segments.begin(); it != segments.end() && !it->file && iovCount < OUTPUT_QUEUE_MAX_IOV; ++it)
+	{
+		size_t offset = (iovCount == 0 ? frontOffset : 0);
+		iov[iovCount].iov_base = const_cast<std::byte *>(it->data->data()) + it->dataStart + offset; // writev only reads it
+		iov[iovCount].iov_len = it->dataLength - offset;
+		attempted += iov[iovCount].iov_len;
+		++iovCount;
+	}
+	ssize_t bytes = writev(fd, iov, iovCount);
+	if (bytes > 0)
+		consume(bytes);
+	return (bytes);
+}
+
+// with zero copy the file is sent by the kernel, no copy goes through user space
+ssize_t OutputQueue::sendFileSegment(int const &fd, size_t &attempted)
+{
+	Segment &segment = segments.front();
+#if defined(__linux__) || defined(__APPLE__)
+	if (segment.zeroCopy)
+	{
+		size_t count = std::min(segment.fileLength, static_cast<size_t>(OUTPUT_QUEUE_SEND_BUDGET));
+		ssize_t bytes;
+#if defined(__linux__)
+		off_t offset = segment.fileOffset;
+		bytes = sendfile(fd, segment.file->getFd(), &offset, count);
+#else
+		off_t length = count;
+		if (sendfile(segment.file->getFd(), fd, segment.fileOffset, &length, nullptr, 0) < 0 && (errno != EAGAIN || length == 0))
+			bytes = -1;
+		else
+			bytes = length; // a partial write on EAGAIN still reports its length
+#endif
+		attempted = count;
+		if (bytes > 0)
+			consume(bytes);
+		return (bytes);
+	}
+#endif
+	return (sendFileWindow(fd, attempted));
+}
+
+// the next window is only read from the file once the previous one is fully sent
+ssize_t OutputQueue::sendFileWindow(int const &fd, size_t &attempted)
+{
+	Segment &segment = segments.front();
+	if (windowStart == windowEnd)
+	{
+		window.resize(windowSize);
+		ssize_t readBytes = pread(segment.file->getFd(), window.data(), std::min(segment.fileLength, window.size()), segment.fileOffset);
+		if (readBytes <= 0) // 0 if the file got shorter since it was opened
+			return (readBytes);
+		windowStart = 0;
+		windowEnd = readBytes;
+	}
+	attempted = windowEnd - windowStart;
+	ssize_t bytes = send(fd, window.data() + windowStart, attempted, 0);
+	if (bytes > 0)
+	{
+		windowStart += bytes;
+		consume(bytes);
+	}
+	return (bytes);
+}
+
+void OutputQueue::releaseWindow()
+{
+	std::vector<std::byte>().swap(window);
+	windowStart = 0;
+	windowEnd = 0;
+}
+
+// move the cursor, dropping the segments that are fully sent
+void OutputQueue::consume(size_t bytes)
+{
+	bytesQueued -= bytes;
+	while (bytes > 0)
+	{
+		Segment &front = segments.front();
+		if (front.file)
+		{
+			front.fileOffset += bytes;
+			front.fileLength -= bytes;
+			bytes = 0;
+			if (front.fileLength == 0)
+			{
+				segments.pop_front();
+				releaseWindow();
+			}
+			continue;
+		}
+		size_t leftInFront = front.dataLength - frontOffset;
+		if (bytes < leftInFront)
+		{
+			frontOffset += bytes;
+			break;
+		}
+		bytes -= leftInFront;
+		segments.pop_front();
+		frontOffset = 0;
+	}
+}
+
+void OutputQueue::clear()
+{
+	segments.clear();
+	frontOffset = 0;
+	bytesQueued = 0;
+	releaseWindow();
+}
+
+bool OutputQueue::empty() const
+{
+	return (bytesQueued == 0);
+}
+
+size_t OutputQueue::size() const
+{
+	return (bytesQueued);
+}
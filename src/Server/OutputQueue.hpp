@@ -0,0 +1,72 @@
+#ifndef OUTPUTQUEUE_HPP
+#define OUTPUTQUEUE_HPP
+
+#include <deque>
+#include <vector>
+#include <string>
+#include <memory>
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <sys/uio.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#ifdef __linux__
+#include <sys/sendfile.h>
+#endif
+
+#include "../Utils/OpenFile.hpp"
+#include "../defines.hpp"
+
+/* Bytes waiting to be sent to a client. Every part of a response (header, body) is its own segment
+ * and is serialized only once. Memory segments hold shared, immutable buffers (a cached file body
+ * is not copied per client) and are sent with writev(), file segments with sendfile()
+ * straight from the open file, or streamed through one fixed-size window when zero copy is off, so
+ * a connection never holds more than one window of the file whatever its size. A cursor into the
+ * front segment remembers how far it got, and a segment is freed as soon as it is fully sent.
+ */
+class OutputQueue
+{
+private:
+	struct Segment
+	{
+		std::shared_ptr<const std::vector<std::byte>> data; // set for a memory segment
+		size_t dataStart; // the segment is data[dataStart, dataStart + dataLength)
+		size_t dataLength;
+		std::shared_ptr<OpenFile> file; // set for a file segment
+		off_t fileOffset; // next byte of the file to send
+		size_t fileLength;
+		bool zeroCopy;
+	};
+
+	std::deque<Segment> segments;
+	size_t frontOffset; // bytes of the front memory segment already sent
+	size_t bytesQueued;
+	std::vector<std::byte> window; // allocated while a streamed file segment is in front
+	size_t windowSize;
+	size_t windowStart; // window[windowStart, windowEnd) is read from the file but not sent yet
+	size_t windowEnd;
+
+	ssize_t sendMemorySegments(int const &fd, size_t &attempted);
+	ssize_t sendFileSegment(int const &fd, size_t &attempted);
+	ssize_t sendFileWindow(int const &fd, size_t &attempted);
+	void releaseWindow();
+	void consume(size_t bytes);
+
+public:
+	OutputQueue();
+
+	void append(std::string const &data);
+	void append(std::vector<std::byte> &&data);
+	void append(std::shared_ptr<const std::vector<std::byte>> const &data);
+	void append(std::shared_ptr<const std::vector<std::byte>> const &data, size_t const &start, size_t const &length);
+	void appendFile(std::shared_ptr<OpenFile> const &file, off_t const &offset, size_t const &length, bool const &zeroCopy);
+	void setWindowSize(size_t const &size);
+	ssize_t sendTo(int const &fd);
+	void clear();
+
+	bool empty() const;
+	size_t size() const;
+};
+
+#endif
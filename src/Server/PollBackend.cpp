@@ -0,0 +1,73 @@
+#include "PollBackend.hpp"
+
+short PollBackend::interestToEvents(Interest const &interest)
+{
+	return (interest == WANT_READ ? POLLIN : POLLOUT);
+}
+
+void PollBackend::addFd(int const &fd, Interest const &interest, uint32_t const &generation)
+{
+	fdToIndex[fd] = pollfds.size();
+	pollfds.push_back({fd, interestToEvents(interest), 0});
+	generations.push_back(generation);
+}
+
+void PollBackend::modifyFd(int const &fd, Interest const &interest, uint32_t const &generation)
+{
+	std::unordered_map<int, size_t>::iterator it = fdToIndex.find(fd);
+	if (it == fdToIndex.end())
+		throw BackendException("PollBackend::fd is not registered");
+	pollfds[it->second].events = interestToEvents(interest);
+	generations[it->second] = generation;
+}
+
+// swap the removed entry with the last one so the vector never has to shift
+void PollBackend::removeFd(int const &fd)
+{
+	std::unordered_map<int, size_t>::iterator it = fdToIndex.find(fd);
+	if (it == fdToIndex.end())
+		return;
+	size_t index = it->second;
+	fdToIndex.erase(it);
+	if (index != pollfds.size() - 1)
+	{
+		pollfds[index] = pollfds.back();
+		generations[index] = generations.back();
+		fdToIndex[pollfds[index].fd] = index;
+	}
+	pollfds.pop_back();
+	generations.pop_back();
+}
+
+int PollBackend::waitForEvents(int const &timeoutMs)
+{
+	events.clear();
+	int ready = poll(pollfds.data(), pollfds.size(), timeoutMs);
+	if (ready <= 0)
+		return (ready);
+	for (size_t i = 0; i < pollfds.size(); ++i)
+	{
+		const pollfd &pfd = pollfds[i];
+		if (!pfd.revents)
+			continue;
+		events.push_back({pfd.fd,
+						  generations[i],
+						  (pfd.revents & POLLIN) != 0,
+						  (pfd.revents & POLLOUT) != 0,
+						  (pfd.revents & POLLHUP) != 0,
+						  (pfd.revents & (POLLERR | POLLNVAL)) != 0});
+		if (static_cast<int>(events.size()) == ready)
+			break;
+	}
+	return (ready);
+}
+
+std::vector<EventBackend::Event> const &PollBackend::getEvents() const
+{
+	return (events);
+}
+
+const char *PollBackend::getName() const
+{
+	return ("poll");
+}
@@ -0,0 +1,31 @@
+#ifndef POLLBACKEND_HPP
+#define POLLBACKEND_HPP
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <sys/poll.h>
+
+#include "EventBackend.hpp"
+
+// poll() based engine, kept for portability and for comparison with epoll
+class PollBackend : public EventBackend
+{
+private:
+	std::vector<pollfd> pollfds;
+	std::vector<uint32_t> generations;		   // of each entry of pollfds
+	std::unordered_map<int, size_t> fdToIndex; // position of each fd in pollfds, so removal is O(1)
+	std::vector<Event> events;
+
+	static short interestToEvents(Interest const &interest);
+
+public:
+	void addFd(int const &fd, Interest const &interest, uint32_t const &generation) override;
+	void modifyFd(int const &fd, Interest const &interest, uint32_t const &generation) override;
+	void removeFd(int const &fd) override;
+	int waitForEvents(int const &timeoutMs) override;
+	std::vector<Event> const &getEvents() const override;
+	const char *getName() const override;
+};
+
+#endif
@@ -1,6 +1,6 @@
 #include "Server.hpp"
 
-Server::Server(ConfigData &config) : serverFd(-1)
+Server::Server(ConfigData const &config) : serverFd(-1), connectionLimiter(nullptr)
 {
 	configs.push_back(config);
 	host = config.getServerHost();
@@ -10,7 +10,7 @@ Server::Server(ConfigData &config) : serverFd(-1)
 	address.sin_addr.s_addr = inet_addr(host.c_str());
 }
 
-void Server::setUpServerSocket()
+void Server::setUpServerSocket(bool const &reusePort)
 {
 	int opt;
 
@@ -22,7 +22,15 @@ void Server::setUpServerSocket()
 		if (setsockopt(serverFd, SOL_SOCKET, SO_REUSEADDR, (char *)&opt, // set file descriptor to be reuseable
 									 sizeof(opt)) < 0)
 			throw SocketSetOptionException();
-		if (fcntl(serverFd, F_SETFL, O_NONBLOCK, FD_CLOEXEC) < 0) // set socket to be nonblocking
+#ifdef SO_REUSEPORT
+		if (reusePort && setsockopt(serverFd, SOL_SOCKET, SO_REUSEPORT, (char *)&opt, // let every worker bind its own socket to the same address
+									sizeof(opt)) < 0)
+			throw SocketSetOptionException();
+#else
+		if (reusePort)
+			throw SocketSetOptionException();
+#endif
+		if (fcntl(serverFd, F_SETFL, O_NONBLOCK) < 0 || fcntl(serverFd, F_SETFD, FD_CLOEXEC) < 0) // set socket to be nonblocking
 			throw SocketSetNonBlockingException();
 		if (bind(serverFd, (struct sockaddr *)&address, sizeof(address)) < 0) // bind the socket to the address and port number
 			throw SocketBindingException();
@@ -36,52 +44,74 @@ void Server::setUpServerSocket()
 	}
 }
 
-int Server::acceptNewConnection()
+// the new socket is created non-blocking and close-on-exec in the same call, the Client is handed over to the caller
+Server::AcceptStatus Server::acceptNewConnection(std::unique_ptr<Client> &client)
 {
 	int clientFd;
 	struct sockaddr_in clientAddress;
 	socklen_t clientAddrlen = sizeof(clientAddress);
 
+#ifdef __linux__
+	clientFd = accept4(serverFd, (struct sockaddr *)&clientAddress, &clientAddrlen, SOCK_NONBLOCK | SOCK_CLOEXEC);
+#else
 	clientFd = accept(serverFd, (struct sockaddr *)&clientAddress, &clientAddrlen);
+	if (clientFd >= 0 && (fcntl(clientFd, F_SETFL, O_NONBLOCK) < 0 || fcntl(clientFd, F_SETFD, FD_CLOEXEC) < 0)) // set socket to be nonblocking
+	{
+		close(clientFd);
+		throw SocketSetNonBlockingException();
+	}
+#endif
 	if (clientFd < 0)
 	{
+		if (errno == EAGAIN || errno == EWOULDBLOCK)
+			return (ACCEPT_QUEUE_EMPTY);
+		if (errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM)
+		{
+			Logger::log(e_log_level::ERROR, SERVER, "Server %s:%d cannot accept client socket: %s", host.c_str(), port, strerror(errno));
+			return (ACCEPT_OUT_OF_FDS);
+		}
 		Logger::log(e_log_level::ERROR, SERVER, "Server %s:%d fails to accept client socket", host.c_str(), port);
-		return (clientFd);
+		return (ACCEPT_FAILED);
 	}
-	clients[clientFd] = std::make_unique<Client>(clientAddress);
+	client = std::make_unique<Client>(clientFd, clientAddress);
 	Logger::log(e_log_level::INFO, CLIENT, "New connection from Client %s:%d to Server %s:%d",
-							inet_ntoa(getClientIPv4Address(clientFd)),
-							ntohs(getClientPortNumber(clientFd)),
+							inet_ntoa(client->getIPv4Address()),
+							ntohs(client->getPortNumber()),
 							host.c_str(),
 							port);
-	if (fcntl(clientFd, F_SETFL, O_NONBLOCK, FD_CLOEXEC) < 0) // set socket to be nonblocking
-	{
-		createAndSendErrorResponse(HttpStatusCode::INTERNAL_SERVER_ERROR, clientFd);
-		close(clientFd);
-		throw SocketSetNonBlockingException();
-	}
-	return (clientFd);
+	return (ACCEPTED);
 }
 
-Server::RequestStatus Server::receiveRequest(int const &clientFd)
+Server::RequestStatus Server::receiveRequest(Client &client)
 {
-	RequestStatus requestStatus = clients[clientFd]->isNewRequest()
-																		? receiveRequestHeader(clientFd)
-																		: receiveRequestBody(clientFd);
+	RequestStatus requestStatus = client.isNewRequest()
+																		? receiveRequestHeader(client)
+																		: receiveRequestBody(client);
+
+	return (completeRequest(client, requestStatus));
+}
 
-	if (requestStatus == REQUEST_CLIENT_DISCONNECT || requestStatus == BODY_IN_CHUNK)
+// an error status becomes the error request, a finished request gets its response
+Server::RequestStatus Server::completeRequest(Client &client, RequestStatus const &requestStatus)
+{
+	if (requestStatus == REQUEST_CLIENT_DISCONNECT || requestStatus == BODY_IN_CHUNK || requestStatus == HEADER_INCOMPLETE ||
+		requestStatus == NO_INPUT || requestStatus == INTERIM_RESPONSE_PENDING)
 		return (requestStatus);
-	else if (requestStatus == SERVER_ERROR || requestStatus == BAD_REQUEST || requestStatus == PAYLOAD_TOO_LARGE)
+	else if (requestStatus == SERVER_ERROR || requestStatus == BAD_REQUEST || requestStatus == PAYLOAD_TOO_LARGE ||
+			 requestStatus == HEADER_TOO_LARGE)
 	{
 		if (requestStatus == SERVER_ERROR)
-			clients[clientFd]->createErrorRequest(configs, HttpStatusCode::INTERNAL_SERVER_ERROR);
+			client.createErrorRequest(configs, HttpStatusCode::INTERNAL_SERVER_ERROR);
 		else if (requestStatus == BAD_REQUEST)
-			clients[clientFd]->createErrorRequest(configs, HttpStatusCode::BAD_REQUEST);
+			client.createErrorRequest(configs, HttpStatusCode::BAD_REQUEST);
 		else if (requestStatus == PAYLOAD_TOO_LARGE)
-			clients[clientFd]->createErrorRequest(configs, HttpStatusCode::PAYLOAD_TOO_LARGE);
-		clients[clientFd]->setIsConnectionClose(true);
+			client.createErrorRequest(configs, HttpStatusCode::PAYLOAD_TOO_LARGE);
+		else if (requestStatus == HEADER_TOO_LARGE)
+			client.createErrorRequest(configs, HttpStatusCode::REQUEST_HEADER_FIELDS_TOO_LARGE);
+		client.setIsConnectionClose(true);
 	}
-	clients[clientFd]->createResponse();
+	client.getInputBuffer().release(); // back to the pool unless a pipelined request is waiting in it
+	client.createResponse();
 	// LINH_CGI
 	// if (response->isCGI())
 	// {
@@ -92,308 +122,267 @@ Server::RequestStatus Server::receiveRequest(int const &clientFd)
 }
 
 // if the request is not created yet, create the request with the request header
-Server::RequestStatus Server::receiveRequestHeader(int const &clientFd)
+Server::RequestStatus Server::receiveRequestHeader(Client &client)
 {
-	std::string requestHeader;
-	std::vector<std::byte> requestBodyBuf;
+	size_t headerLength = 0;
 
-	RequestStatus requestStatus = formRequestHeader(clientFd, requestHeader, requestBodyBuf);
+	RequestStatus requestStatus = formRequestHeader(client, headerLength);
 	if (requestStatus != HEADER_DELIMITER_FOUND)
 		return (requestStatus);
 
-	clients[clientFd]->createRequest(requestHeader, configs);
-	clients[clientFd]->appendToBodyBuf(requestBodyBuf);
-	Request request = clients[clientFd]->getRequest();
+	client.createRequest(headerLength, configs);
+	Request const &request = client.getRequest();
 	if (HttpUtils::_httpMethodToStr.find(request.getMethod()) != HttpUtils::_httpMethodToStr.end())
 		Logger::log(e_log_level::INFO, CLIENT, "Request from Client %s:%d - Method: %s, Target: %s",
-								inet_ntoa(getClientIPv4Address(clientFd)),
-								ntohs(getClientPortNumber(clientFd)),
+								inet_ntoa(client.getIPv4Address()),
+								ntohs(client.getPortNumber()),
 								HttpUtils::_httpMethodToStr.at(request.getMethod()).c_str(),
 								request.getTarget().c_str());
 	else
 		Logger::log(e_log_level::INFO, CLIENT, "Invalid HTTP method received from Client %s:%d",
-								inet_ntoa(getClientIPv4Address(clientFd)),
-								ntohs(getClientPortNumber(clientFd)));
+								inet_ntoa(client.getIPv4Address()),
+								ntohs(client.getPortNumber()));
 
+	if (request.getStatusCode() != HttpStatusCode::UNDEFINED_STATUS) // rejected head, whatever was sent after it is dropped
+	{
+		client.getInputBuffer().consume(client.getInputBuffer().size());
+		if (request.isBodyExpected())
+			client.setIsConnectionClose(true);
+		return (READY_TO_WRITE);
+	}
+	if (request.expectsContinue())
+		return (answerExpectContinue(client));
 	if (request.isBodyExpected())
-		return (processRequestHeaderBuf(clientFd));
+		return (processInputBuffer(client));
 	return (READY_TO_WRITE);
 }
 
-Server::RequestStatus Server::formRequestHeader(int const &clientFd, std::string &requestHeader, std::vector<std::byte> &requestBodyBuf)
+/* The client holds the body back until it is told to go on. A request that would be refused
+ * anyway is answered right away without its body, and the connection is closed as the body may
+ * still be sent. Otherwise 100 Continue is queued like any response and the body is only read
+ * once it is all out, unless the body is already coming.
+ */
+Server::RequestStatus Server::answerExpectContinue(Client &client)
 {
-	ssize_t bytes;
-	char buf[MAX_REQUEST_HEADER_LENGTH];
-
-	if ((bytes = recv(clientFd, buf, sizeof(buf), 0)) > 0)
-	{
-		requestHeader.append(buf, bytes);
-		size_t delimiterPos = requestHeader.find(CRLF CRLF);
-		if (delimiterPos != std::string::npos)
-		{
-			for (size_t i = delimiterPos + sizeof(CRLF CRLF) - 1; i < requestHeader.size(); ++i)
-				requestBodyBuf.push_back(static_cast<std::byte>(requestHeader[i]));
-			requestHeader.resize(delimiterPos);
-			return (HEADER_DELIMITER_FOUND);
-		}
-		else
-		{
-			if (requestHeader.size() == MAX_REQUEST_HEADER_LENGTH) // the header is larger than the max header length
-				return (PAYLOAD_TOO_LARGE);
-			else // cannot find delimiter
-				return (BAD_REQUEST);
-		}
-	}
-	else
+	RequestStatus bodyStatus = checkExpectedBody(client.getRequest());
+	if (bodyStatus != BODY_IN_CHUNK)
 	{
-		if (bytes == 0)
-		{
-			Logger::log(e_log_level::INFO, CLIENT, "Client %s:%d disconnected",
-									inet_ntoa(getClientIPv4Address(clientFd)),
-									ntohs(getClientPortNumber(clientFd)));
-			return (REQUEST_CLIENT_DISCONNECT);
-		}
-		else
-		{
-			Logger::log(e_log_level::ERROR, SERVER, "Server %s:%d fails to receive request from Client %s:%d", host.c_str(), port,
-									inet_ntoa(getClientIPv4Address(clientFd)),
-									ntohs(getClientPortNumber(clientFd)));
-			return (SERVER_ERROR);
-		}
+		client.setIsConnectionClose(true);
+		return (bodyStatus);
 	}
+	if (!client.getInputBuffer().empty())
+		return (processInputBuffer(client));
+	client.getOutputQueue().append(std::string(CONTINUE_RESPONSE));
+	return (flushInterimResponse(client));
 }
 
-// process any remaining data in the body buffer from request header
-Server::RequestStatus Server::processRequestHeaderBuf(int const &clientFd)
+/* The same checks the response makes before it looks at a body: a location for the target that
+ * accepts the method, and a Content-Length within its client_max_body_size. READY_TO_WRITE when the
+ * request is answered without its body, BODY_IN_CHUNK when the body is wanted.
+ */
+Server::RequestStatus Server::checkExpectedBody(Request const &request)
 {
-	Request request = clients[clientFd]->getRequest();
-
-	if (clients[clientFd]->getBodyBuf().size() == 0)
+	try
+	{
+		Location location = request.getConfig().getMatchingLocation(request.getTarget());
+		if (location.getAcceptedMethods().count(request.getMethod()) == 0)
+			return (READY_TO_WRITE);
+		if (!request.isChunked() && request.getContentLength() > location.getMaxBodySize())
+			return (PAYLOAD_TOO_LARGE);
 		return (BODY_IN_CHUNK);
-	else
+	}
+	catch (std::exception const &e)
 	{
-		if (request.isChunked())
-			return (processChunkData(clientFd));
-		else
-		{
-			clients[clientFd]->appendToRequestBody(clients[clientFd]->getBodyBuf());
-			clients[clientFd]->clearBodyBuf();
-			size_t bodySize = clients[clientFd]->getRequestBody().size();
-			size_t contentLength = request.getContentLength();
-			if (bodySize < contentLength)
-				return (BODY_IN_CHUNK);
-			else if (bodySize == contentLength)
-				return (READY_TO_WRITE);
-			else
-				return (BAD_REQUEST);
-		}
+		return (READY_TO_WRITE);
 	}
 }
 
-Server::RequestStatus Server::receiveRequestBody(int const &clientFd)
+// what the socket takes of the queued 100 Continue, the body waiting in the input buffer is parsed once it is all out
+Server::RequestStatus Server::flushInterimResponse(Client &client)
 {
-	Request request = clients[clientFd]->getRequest();
-	ssize_t bytes;
-	char buf[SERVER_BUFFER_SIZE];
+	OutputQueue &output = client.getOutputQueue();
 
-	if ((bytes = recv(clientFd, buf, sizeof(buf), 0)) > 0)
+	if (output.sendTo(client.getFd()) < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
 	{
-		if (request.getStatusCode() == HttpStatusCode::UNDEFINED_STATUS)
-			return (request.isChunked()
-									? formRequestBodyWithChunk(clientFd, buf, bytes)
-									: formRequestBodyWithContentLength(clientFd, buf, bytes));
-		else
-		{
-			clients[clientFd]->setIsConnectionClose(true);
-			return (READY_TO_WRITE);
-		}
-	}
-	else
-	{
-		if (bytes == 0)
-		{
-			Logger::log(e_log_level::INFO, CLIENT, "Client %s:%d disconnected",
-									inet_ntoa(getClientIPv4Address(clientFd)),
-									ntohs(getClientPortNumber(clientFd)));
-			return (REQUEST_CLIENT_DISCONNECT);
-		}
-		else
-		{
-			Logger::log(e_log_level::ERROR, SERVER, "Server %s:%d fails to receive request from Client %s:%d",
-									host.c_str(),
-									port,
-									inet_ntoa(getClientIPv4Address(clientFd)),
-									ntohs(getClientPortNumber(clientFd)));
-			return (SERVER_ERROR);
-		}
+		Logger::log(e_log_level::ERROR, SERVER, "Server %s:%d fails to send 100 Continue to Client %s:%d", host.c_str(), port,
+								inet_ntoa(client.getIPv4Address()),
+								ntohs(client.getPortNumber()));
+		return (REQUEST_CLIENT_DISCONNECT);
 	}
+	if (!output.empty())
+		return (INTERIM_RESPONSE_PENDING);
+	return (processInputBuffer(client));
 }
 
-Server::RequestStatus Server::formRequestBodyWithContentLength(int const &clientFd, char readBuf[], ssize_t const &bytes)
+// the rest of the 100 Continue on a writable event, the request goes on like after a read
+Server::RequestStatus Server::sendInterimResponse(Client &client)
 {
-	clients[clientFd]->appendToRequestBody(readBuf, bytes);
-	size_t bodySize = clients[clientFd]->getRequestBody().size();
-	size_t contentLength = clients[clientFd]->getRequest().getContentLength();
-	if (bodySize < contentLength)
-		return (BODY_IN_CHUNK);
-	else if (bodySize == contentLength)
-		return (READY_TO_WRITE);
-	else
-		return (BAD_REQUEST);
+	return (completeRequest(client, flushInterimResponse(client)));
 }
 
-Server::RequestStatus Server::formRequestBodyWithChunk(int const &clientFd, char readBuf[], ssize_t const &bytes)
+/* The head may come in several reads, what arrived so far waits in the client's input buffer
+ * for the next readable event. Nothing is read while a pipelined request that came with the
+ * previous one was not searched yet. The limit is the client_max_header_size of the default
+ * server, the one that is picked before the Host header is known.
+ */
+Server::RequestStatus Server::formRequestHeader(Client &client, size_t &headerLength)
 {
-	if (!clients[clientFd]->getBodyBuf().empty()) // process any remaining data from the former chunk
-	{
-		RequestStatus requestStatus = processChunkData(clientFd);
-		if (requestStatus != BODY_IN_CHUNK)
-			return (requestStatus);
-	}
+	ssize_t bytes = 0;
+	size_t maxHeaderSize = configs.front().getMaxHeaderSize();
+
+	if (!client.hasUnscannedInput() && (bytes = receiveInput(client)) <= 0)
+		return (emptyReceiveStatus(bytes));
+	headerLength = client.findHeaderDelimiter();
+	if (headerLength != std::string::npos)
+		return (headerLength > maxHeaderSize ? HEADER_TOO_LARGE : HEADER_DELIMITER_FOUND);
+	if (client.getInputBuffer().size() > maxHeaderSize + sizeof(CRLF CRLF) - 2) // no room left for the head and its empty line
+		return (HEADER_TOO_LARGE);
+	return (HEADER_INCOMPLETE); // the rest of the header is still on its way
+}
 
-	clients[clientFd]->appendToBodyBuf(readBuf, bytes);
-	return (processChunkData(clientFd));
+// one recv() straight into the client's input buffer
+ssize_t Server::receiveInput(Client &client)
+{
+	ssize_t bytes = client.getInputBuffer().receiveFrom(client.getFd());
+
+	if (bytes == 0)
+		Logger::log(e_log_level::INFO, CLIENT, "Client %s:%d disconnected",
+								inet_ntoa(client.getIPv4Address()),
+								ntohs(client.getPortNumber()));
+	else if (bytes < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+		Logger::log(e_log_level::ERROR, SERVER, "Server %s:%d fails to receive request from Client %s:%d",
+								host.c_str(),
+								port,
+								inet_ntoa(client.getIPv4Address()),
+								ntohs(client.getPortNumber()));
+	return (bytes);
 }
 
-Server::RequestStatus Server::processChunkData(int const &clientFd)
+// a receive that brought nothing: the client left, the readiness was spurious or stale, or recv() failed
+Server::RequestStatus Server::emptyReceiveStatus(ssize_t const &bytes) const
 {
-	if (clients[clientFd]->getChunkSize() == 0) // if not yet parse the chunk size or the chunk size is 0
+	if (bytes == 0)
+		return (REQUEST_CLIENT_DISCONNECT);
+	if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+		return (NO_INPUT);
+	return (SERVER_ERROR);
+}
+
+// the body bytes waiting in the input buffer are parsed, what comes after the body stays there for the next request
+Server::RequestStatus Server::processInputBuffer(Client &client)
+{
+	if (client.getInputBuffer().empty())
+		return (BODY_IN_CHUNK);
+	try
 	{
-		RequestStatus requestStatus = extractChunkSize(clientFd);
-		if (requestStatus != PARSED_CHUNK_SIZE)
-			return (requestStatus);
+		RequestStatus requestStatus = client.getRequest().isChunked()
+																		? formRequestBodyWithChunk(client)
+																		: formRequestBodyWithContentLength(client);
+		MultipartParser const *parser = client.getRequest().getMultipartParser();
+		if (parser != nullptr && parser->getStatus() == MultipartParser::MULTIPART_TOO_LARGE)
+			return (PAYLOAD_TOO_LARGE); // more parts than it takes, the rest of the body is not read
+		return (requestStatus);
 	}
-
-	clients[clientFd]->appendToRequestBody(clients[clientFd]->getBodyBuf());
-	clients[clientFd]->clearBodyBuf();
-
-	std::vector<std::byte> body = clients[clientFd]->getRequestBody();
-
-	if (body.size() >= clients[clientFd]->getBytesToReceive() + (sizeof(CRLF) - 1)) // last buffer for the chunk
+	catch (RequestBody::SpoolException const &e) // a body over client_body_buffer_size could not be written to its temp file
 	{
-		std::string final_chunk = "0" CRLF CRLF;
-		if (body.size() > final_chunk.length() && std::memcmp(body.data() + body.size() - final_chunk.length(), final_chunk.data(), final_chunk.length()) == 0) // if the chunk contains final chunk at the end
-		{
-			if (body.size() == final_chunk.size() && std::memcmp(body.data(), final_chunk.data(), final_chunk.length()) == 0)
-				return (READY_TO_WRITE);
-			RequestStatus requestStatus = READY_TO_WRITE;
-			do
-			{
-				clients[clientFd]->appendToRequestBody(clients[clientFd]->getBodyBuf());
-				clients[clientFd]->clearBodyBuf();
-				body = clients[clientFd]->getRequestBody();
-				if (static_cast<char>(body[clients[clientFd]->getBytesToReceive()]) != '\r' || static_cast<char>(body[clients[clientFd]->getBytesToReceive() + 1]) != '\n') // delimiter is not CRLF
-					return (BAD_REQUEST);
-				std::vector<std::byte> bodyBuf(body.begin() + clients[clientFd]->getBytesToReceive() + (sizeof(CRLF) - 1), body.end());
-				clients[clientFd]->appendToBodyBuf(bodyBuf);
-				clients[clientFd]->resizeRequestBody(clients[clientFd]->getBytesToReceive());
-				clients[clientFd]->setChunkSize(0);
-				requestStatus = extractChunkSize(clientFd);
-			} while (requestStatus == PARSED_CHUNK_SIZE);
-			return (requestStatus);
-		}
-		if (static_cast<char>(body[clients[clientFd]->getBytesToReceive()]) != '\r' || static_cast<char>(body[clients[clientFd]->getBytesToReceive() + 1]) != '\n') // delimiter is not CRLF
-			return (BAD_REQUEST);
-
-		std::vector<std::byte> bodyBuf(body.begin() + clients[clientFd]->getBytesToReceive() + (sizeof(CRLF) - 1), body.end());
-		clients[clientFd]->appendToBodyBuf(bodyBuf);
-		clients[clientFd]->resizeRequestBody(clients[clientFd]->getBytesToReceive());
-		clients[clientFd]->setChunkSize(0);
-		return (BODY_IN_CHUNK);
+		Logger::log(e_log_level::ERROR, SERVER, "Server %s:%d: %s: %s", host.c_str(), port, e.what(), strerror(errno));
+		return (SERVER_ERROR);
 	}
-	return (BODY_IN_CHUNK);
 }
 
-Server::RequestStatus Server::extractChunkSize(int const &clientFd)
+Server::RequestStatus Server::receiveRequestBody(Client &client)
 {
-	std::vector<std::byte> bodyBuf = clients[clientFd]->getBodyBuf();
+	ssize_t bytes;
 
-	std::string final_chunk = "0" CRLF CRLF;
-	if (std::memcmp(bodyBuf.data(), final_chunk.data(), std::min(final_chunk.length(), bodyBuf.size())) == 0)
+	if ((bytes = receiveInput(client)) <= 0)
+		return (emptyReceiveStatus(bytes));
+	if (client.getRequest().getStatusCode() != HttpStatusCode::UNDEFINED_STATUS)
 	{
-		if (bodyBuf.size() == final_chunk.length())
-			return (READY_TO_WRITE);
-		else if (bodyBuf.size() > final_chunk.length())
-			return (BAD_REQUEST);
-		else
-			return (BODY_IN_CHUNK);
+		client.setIsConnectionClose(true);
+		return (READY_TO_WRITE);
 	}
+	return (processInputBuffer(client));
+}
 
-	std::vector<std::byte> delimiter = {std::byte('\r'), std::byte('\n')};
-	auto delimiterPos = std::search(bodyBuf.begin(), bodyBuf.end(), delimiter.begin(), delimiter.end());
-	if (delimiterPos != bodyBuf.end()) // if CRLF is found, extract the chunk size
-	{
-		std::string chunk_size;
-		for (auto it = bodyBuf.begin(); it != delimiterPos; ++it)
-			chunk_size.push_back(static_cast<char>(*it));
-		if (chunk_size.length() > 0 && std::all_of(chunk_size.begin(), chunk_size.end(), ::isxdigit)) // if the chunk size only contains hexadecimal character
-		{
-			clients[clientFd]->setChunkSize(std::stoi(chunk_size, nullptr, 16));
+Server::RequestStatus Server::formRequestBodyWithContentLength(Client &client)
+{
+	InputBuffer &input = client.getInputBuffer();
+	Request const &request = client.getRequest();
+	size_t bytes = std::min(request.getContentLength() - request.getBodySize(), input.size());
 
-			clients[clientFd]->setBytesToReceive(clients[clientFd]->getBytesToReceive() + clients[clientFd]->getChunkSize());
-			clients[clientFd]->eraseBodyBuf(0, std::distance(bodyBuf.begin(), delimiterPos) + (sizeof(CRLF) - 1)); // remove the chunk size from body buffer
-			return (PARSED_CHUNK_SIZE);
-		}
-		else // if the chunk size contains non-hexadecimal character
-			return (BAD_REQUEST);
-	}
-	else // if CRLF is not found
+	client.appendToRequestBody(input.peek(), bytes);
+	input.consume(bytes);
+	if (request.getBodySize() < request.getContentLength())
+		return (BODY_IN_CHUNK);
+	return (READY_TO_WRITE);
+}
+
+// the decoder keeps its place between reads, every received byte is decoded once
+Server::RequestStatus Server::formRequestBodyWithChunk(Client &client)
+{
+	InputBuffer &input = client.getInputBuffer();
+	size_t consumed = 0;
+
+	ChunkedDecoder::Status status = client.appendChunkedToRequestBody(reinterpret_cast<const std::byte *>(input.peek()), input.size(), consumed);
+	input.consume(consumed);
+	switch (status)
 	{
-		std::string bodyBufStr;
-		for (auto &ch : bodyBuf)
-			bodyBufStr.push_back(static_cast<char>(ch));
-		if (!std::all_of(bodyBufStr.begin(), bodyBufStr.end(), ::isxdigit))
-			return (BAD_REQUEST);
-		else
-			return (BODY_IN_CHUNK);
+	case ChunkedDecoder::CHUNKED_COMPLETE:
+		return (READY_TO_WRITE);
+	case ChunkedDecoder::CHUNKED_INCOMPLETE:
+		return (BODY_IN_CHUNK);
+	case ChunkedDecoder::CHUNKED_TOO_LARGE:
+		return (PAYLOAD_TOO_LARGE);
+	default:
+		return (BAD_REQUEST);
 	}
 }
 
-Server::ResponseStatus Server::sendResponse(int const &clientFd)
+Server::ResponseStatus Server::sendResponse(Client &client)
 {
-	Response response = clients[clientFd]->getResponse();
-	std::vector<std::byte> formatedResponse = response.formatResponse();
+	Response const &response = client.getResponse();
 
 	ssize_t bytes;
-	if ((bytes = send(clientFd, &(*(formatedResponse.begin() + clients[clientFd]->getBytesSent())), std::min(formatedResponse.size() - clients[clientFd]->getBytesSent(), static_cast<size_t>(SERVER_BUFFER_SIZE)), 0)) > 0)
+	if ((bytes = client.getOutputQueue().sendTo(client.getFd())) > 0)
 	{
-		clients[clientFd]->setBytesSent(clients[clientFd]->getBytesSent() + bytes);
-		if (clients[clientFd]->getBytesSent() < formatedResponse.size())
+		if (!client.getOutputQueue().empty())
 			return (RESPONSE_IN_CHUNK);
 		else
 		{
 			Logger::log(e_log_level::INFO, CLIENT, "Response sent to Client %s:%d - Status: %d",
-									inet_ntoa(getClientIPv4Address(clientFd)),
-									ntohs(getClientPortNumber(clientFd)),
+									inet_ntoa(client.getIPv4Address()),
+									ntohs(client.getPortNumber()),
 									response.getStatusCode());
-			if (clients[clientFd]->getRequest().getConnection() == ConnectionValue::CLOSE || clients[clientFd]->getIsConnectionClose() == true)
+			if (client.getRequest().getConnection() == ConnectionValue::CLOSE || client.getIsConnectionClose() == true)
 				return (RESPONSE_DISCONNECT_CLIENT);
-			clients[clientFd]->removeRequest();
-			clients[clientFd]->removeResponse();
+			client.removeRequest();
+			client.removeResponse();
 			return (KEEP_ALIVE); // keep the connection alive by default
 		}
 	}
+	else if (bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+		return (RESPONSE_IN_CHUNK); // the socket was not writable after all, nothing was lost
 	else
 	{
 		if (bytes == 0)
 			Logger::log(e_log_level::INFO, CLIENT, "Client %s:%d disconnected",
-									inet_ntoa(getClientIPv4Address(clientFd)),
-									ntohs(getClientPortNumber(clientFd)));
+									inet_ntoa(client.getIPv4Address()),
+									ntohs(client.getPortNumber()));
 		else
 			Logger::log(e_log_level::ERROR, SERVER, "Server %s:%d fails to send response to Client %s:%d",
 									host.c_str(),
 									port,
-									inet_ntoa(getClientIPv4Address(clientFd)),
-									ntohs(getClientPortNumber(clientFd)));
+									inet_ntoa(client.getIPv4Address()),
+									ntohs(client.getPortNumber()));
 		return (RESPONSE_DISCONNECT_CLIENT);
 	}
 }
 
-void Server::createAndSendErrorResponse(HttpStatusCode const &statusCode, int const &clientFd)
+void Server::createAndSendErrorResponse(HttpStatusCode const &statusCode, Client &client)
 {
-	clients[clientFd]->createErrorRequest(configs, statusCode);
-	clients[clientFd]->createResponse();
-	sendResponse(clientFd);
+	client.createErrorRequest(configs, statusCode);
+	client.createResponse();
+	sendResponse(client);
 }
 
 int const &Server::getServerFd() const
@@ -411,27 +400,25 @@ int const &Server::getPort()
 	return (port);
 }
 
-unsigned short int const &Server::getClientPortNumber(int const &clientFd)
+// the deadlines come from the default server block, the virtual host is not known before the header is parsed
+size_t Server::getTimeoutMs(ClientTimeout const &timeout) const
 {
-	return (clients[clientFd]->getPortNumber());
+	return (configs.front().getTimeoutMs(timeout));
 }
 
-in_addr const &Server::getClientIPv4Address(int const &clientFd)
+void Server::appendConfig(ConfigData const &config)
 {
-	return (clients[clientFd]->getIPv4Address());
+	configs.push_back(config);
 }
 
-void Server::appendConfig(ConfigData const &config)
+void Server::setConnectionLimiter(ConnectionLimiter &limiter)
 {
-	configs.push_back(config);
+	connectionLimiter = &limiter;
 }
 
-void Server::removeClient(int const &clientFd)
+ConnectionLimiter &Server::getConnectionLimiter()
 {
-	Logger::log(e_log_level::INFO, CLIENT, "Client %s:%d is removed",
-							inet_ntoa(getClientIPv4Address(clientFd)),
-							ntohs(getClientPortNumber(clientFd)));
-	clients.erase(clientFd);
+	return (*connectionLimiter);
 }
 
 const char *Server::SocketCreationException::what() const throw()
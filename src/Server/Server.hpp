@@ -13,8 +13,11 @@
 #include <algorithm>
 #include <unistd.h>
 #include <memory>
+#include <cstring>
+#include <cerrno>
 
 #include "Client.hpp"
+#include "AdmissionControl.hpp"
 #include "../Request/Request.hpp"
 #include "../Response/Response.hpp"
 #include "../Config/ConfigParser.hpp"
@@ -28,16 +31,27 @@ public:
 	enum RequestStatus
 	{
 		HEADER_DELIMITER_FOUND,
+		HEADER_INCOMPLETE,
+		HEADER_TOO_LARGE,
+		NO_INPUT,				  // the socket had nothing to read after all, the request is where it was
+		INTERIM_RESPONSE_PENDING, // 100 Continue waits in the output queue, the body is read once it is sent
 		BAD_HEADER,
 		REQUEST_CLIENT_DISCONNECT,
 		BODY_IN_CHUNK,
 		READY_TO_WRITE,
-		PARSED_CHUNK_SIZE,
 		BAD_REQUEST,
 		SERVER_ERROR,
 		PAYLOAD_TOO_LARGE
 	};
 
+	enum AcceptStatus
+	{
+		ACCEPTED,
+		ACCEPT_QUEUE_EMPTY,
+		ACCEPT_OUT_OF_FDS,
+		ACCEPT_FAILED
+	};
+
 	enum ResponseStatus
 	{
 		RESPONSE_IN_CHUNK,
@@ -48,38 +62,43 @@ public:
 private:
 	int serverFd;
 	std::vector<ConfigData> configs;
-	std::unordered_map<int, std::unique_ptr<Client>> clients;
 	struct sockaddr_in address;
 	std::string host;
 	int port;
-
-	RequestStatus receiveRequestHeader(int const &clientFd);
-	RequestStatus formRequestHeader(int const &clientFd, std::string &requestHeader, std::vector<std::byte> &requestBodyBuf);
-	RequestStatus processRequestHeaderBuf(int const &clientFd);
-	RequestStatus receiveRequestBody(int const &clientFd);
-	RequestStatus formRequestBodyWithContentLength(int const &clientFd, char readBuf[], ssize_t const &bytes);
-	RequestStatus formRequestBodyWithChunk(int const &clientFd, char readBuf[], ssize_t const &bytes);
-	RequestStatus processChunkData(int const &clientFd);
-	RequestStatus extractChunkSize(int const &clientFd);
+	ConnectionLimiter *connectionLimiter;
+
+	RequestStatus receiveRequestHeader(Client &client);
+	RequestStatus formRequestHeader(Client &client, size_t &headerLength);
+	ssize_t receiveInput(Client &client);
+	RequestStatus emptyReceiveStatus(ssize_t const &bytes) const;
+	RequestStatus processInputBuffer(Client &client);
+	RequestStatus completeRequest(Client &client, RequestStatus const &requestStatus);
+	RequestStatus answerExpectContinue(Client &client);
+	static RequestStatus checkExpectedBody(Request const &request);
+	RequestStatus flushInterimResponse(Client &client);
+	RequestStatus receiveRequestBody(Client &client);
+	RequestStatus formRequestBodyWithContentLength(Client &client);
+	RequestStatus formRequestBodyWithChunk(Client &client);
 	Server();
 
 public:
-	Server(ConfigData &config);
+	Server(ConfigData const &config);
 
-	void setUpServerSocket();
-	int acceptNewConnection();
-	RequestStatus receiveRequest(int const &clientFd);
-	ResponseStatus sendResponse(int const &clientFd);
-	void createAndSendErrorResponse(HttpStatusCode const &statusCode, int const &clientFd);
+	void setUpServerSocket(bool const &reusePort);
+	AcceptStatus acceptNewConnection(std::unique_ptr<Client> &client);
+	RequestStatus receiveRequest(Client &client);
+	RequestStatus sendInterimResponse(Client &client);
+	ResponseStatus sendResponse(Client &client);
+	void createAndSendErrorResponse(HttpStatusCode const &statusCode, Client &client);
 
 	int const &getServerFd() const;
 	std::string const &getHost();
 	int const &getPort();
-	unsigned short int const &getClientPortNumber(int const &clientFd);
-	in_addr const &getClientIPv4Address(int const &clientFd);
+	size_t getTimeoutMs(ClientTimeout const &timeout) const;
 
 	void appendConfig(ConfigData const &config);
-	void removeClient(int const &clientFd);
+	void setConnectionLimiter(ConnectionLimiter &limiter);
+	ConnectionLimiter &getConnectionLimiter();
 
 	class SocketCreationException : public std::exception
 	{
@@ -2,6 +2,7 @@
 
 ServerManager *serverManagerPtr = nullptr;
 volatile sig_atomic_t shutdownFlag = 0; // flag for shutting down the server
+volatile sig_atomic_t metricsRequests = 0; // SIGUSR1 received so far, every worker logs its counters once per signal
 
 void interruptHandler(int signum)
 {
@@ -9,6 +10,12 @@ void interruptHandler(int signum)
 	shutdownFlag = 1;
 }
 
+void metricsHandler(int signum)
+{
+	(void)signum;
+	metricsRequests = metricsRequests + 1;
+}
+
 void segfaultHandler(int signum)
 {
 	(void)signum;
@@ -21,24 +28,27 @@ void segfaultHandler(int signum)
 	}
 }
 
-void ServerManager::initServer(const std::vector<ConfigData> &sparsedConfigs)
+ServerManager::ServerManager() : exitStatus(EXIT_SUCCESS)
+{
+}
+
+void ServerManager::initServer(const std::vector<ConfigData> &sparsedConfigs, const GlobalConfig &parsedGlobalConfig)
 {
 	serverConfigs = sparsedConfigs;
+	globalConfig = parsedGlobalConfig;
 }
 
 int ServerManager::runServer()
 {
 	serverManagerPtr = this;
 	signal(SIGINT, interruptHandler);
+	signal(SIGUSR1, metricsHandler);
 	signal(SIGSEGV, segfaultHandler);
+	signal(SIGPIPE, SIG_IGN); // a client closing early makes send() fail with EPIPE instead of killing the server
 
 	try
 	{
-		createServers();
-		startServerLoop();
-		Logger::log(e_log_level::INFO, SERVER, "Interrupt signal received");
-		cleanUpForServerShutdown(HttpStatusCode::INTERNAL_SERVER_ERROR);
-		return EXIT_SUCCESS;
+		createWorkers();
 	}
 	catch (std::exception &e)
 	{
@@ -46,187 +56,76 @@ int ServerManager::runServer()
 		cleanUpForServerShutdown(HttpStatusCode::INTERNAL_SERVER_ERROR);
 		return EXIT_FAILURE;
 	}
+	if (workers.size() == 1) // a single worker runs the loop on the main thread
+		exitStatus = workers.front()->runWorker();
+	else
+		runWorkerThreads();
+	if (shutdownFlag)
+		Logger::log(e_log_level::INFO, SERVER, "Interrupt signal received");
+	return exitStatus;
 }
 
-void ServerManager::createServers()
-{
-	for (ConfigData &config : serverConfigs)
-	{
-		const std::pair<const int, std::unique_ptr<Server>> *serverPtr = findServer(config.getServerHost(), config.getServerPort());
-
-		if (serverPtr == nullptr) // if it is a new server
-		{
-			std::unique_ptr<Server> server = std::make_unique<Server>(config);
-			server->setUpServerSocket();
-			Logger::log(e_log_level::INFO, SERVER, "Server created - Host: %s, Port: %d, Server Name: %s",
-									server->getHost().c_str(),
-									server->getPort(),
-									config.getServerName().c_str());
-			int serverFd = server->getServerFd();
-			servers[serverFd] = std::move(server);		// insert server into map
-			pollfds.push_back({serverFd, POLLIN, 0}); // add the server socket to poll fd
-		}
-		else
-		{
-			serverPtr->second->appendConfig(config);
-			Logger::log(e_log_level::INFO, SERVER, "Configuration of Server Name %s added to Server %s:%d",
-									config.getServerName().c_str(),
-									config.getServerHost().c_str(),
-									config.getServerPort());
-		}
-	}
-}
-
-const std::pair<const int, std::unique_ptr<Server>> *ServerManager::findServer(const std::string &host, const int &port) const
-{
-	for (const std::pair<const int, std::unique_ptr<Server>> &server : servers)
-	{
-		if (server.second->getHost() == host && server.second->getPort() == port)
-			return &server;
-	}
-	return nullptr;
-}
-
-// start the main server loop
-void ServerManager::startServerLoop()
+// every worker gets its own SO_REUSEPORT listening socket for each Server, so the kernel spreads the accepts
+void ServerManager::createWorkers()
 {
-	while (!shutdownFlag)
+	int workerCount = globalConfig.getWorkerThreads();
+	admissionControl = std::make_unique<AdmissionControl>(globalConfig, serverConfigs); // the connection limits are shared by all workers
+	for (int id = 0; id < workerCount; ++id)
 	{
-		handlePoll();
-		for (std::list<pollfd>::iterator it = pollfds.begin(); it != pollfds.end() && !shutdownFlag; ++it) // loop through all pollfds to check which events have occurred
-		{
-			if (!it->revents)
-				continue;
-			else if (it->revents & POLLIN)
-				handleReadyToRead(it);
-			else if (it->revents & POLLOUT)
-				handleReadyToWrite(it);
-			else if (it->revents & POLLHUP && clientToServerMap.find(it->fd) != clientToServerMap.end())
-			{
-				int clientFd = it->fd;
-				int serverFd = clientToServerMap[clientFd];
-				Logger::log(e_log_level::INFO, CLIENT, "Client %s:%d disconnect",
-										inet_ntoa(servers[serverFd]->getClientIPv4Address(clientFd)),
-										ntohs(servers[serverFd]->getClientPortNumber(clientFd)));
-				handleClientDisconnection(it);
-			}
-			else
-				throw ReventErrorFlagException();
-		}
+		workers.push_back(std::make_unique<Worker>(id, serverConfigs, globalConfig, workerCount > 1, *admissionControl));
+		workers.back()->setUpWorker();
 	}
+	Logger::log(e_log_level::INFO, SERVER, "%d worker(s) ready", workerCount);
 }
 
-// copy list to vector for poll, and then move vector back to list
-void ServerManager::handlePoll()
-{
-	std::vector<pollfd> pollfdsTmp(pollfds.begin(), pollfds.end()); // create a vector to hold the pollfds temporarily
-
-	int ready = poll(pollfdsTmp.data(), pollfdsTmp.size(), SERVER_TIMEOUT); // call poll using the vector's data
-
-	pollfds.clear();
-	pollfds.insert(pollfds.end(), pollfdsTmp.begin(), pollfdsTmp.end()); // move the contents back from the vector
-
-	if (shutdownFlag == 1)
-		return;
-
-	if (ready < 0)
-		throw PollException();
-	else // check timeout for each client socket
-		checkClientTimeout(ready);
-}
-
-// disconnect client socket if the client timeout or poll timeout
-void ServerManager::checkClientTimeout(int const &ready)
+/* SIGINT and SIGUSR1 are blocked in the worker threads so that they are always delivered to the main
+ * thread, which then wakes every worker up, to finish or to log its metrics.
+ */
+void ServerManager::runWorkerThreads()
 {
-	for (std::list<pollfd>::iterator it = pollfds.begin(); it != pollfds.end(); ++it)
+	sigset_t blockSet;
+	sigset_t oldSet;
+	sigemptyset(&blockSet);
+	sigaddset(&blockSet, SIGINT);
+	sigaddset(&blockSet, SIGUSR1);
+	pthread_sigmask(SIG_BLOCK, &blockSet, &oldSet);
+
+	for (std::unique_ptr<Worker> &worker : workers)
 	{
-		if (clientToServerMap.find(it->fd) != clientToServerMap.end())
-		{
-			std::chrono::duration<double> elapsedSeconds = std::chrono::steady_clock::now() - clientLastActiveTime[it->fd];
-			if (ready == 0 || elapsedSeconds.count() >= SERVER_TIMEOUT / 1000) // if poll timeout or the client timeout
+		Worker *workerPtr = worker.get();
+		workerThreads.emplace_back([this, workerPtr]()
+								   {
+			if (workerPtr->runWorker() != EXIT_SUCCESS)
 			{
-				int clientFd = it->fd;
-				int serverFd = clientToServerMap[clientFd];
-				Logger::log(e_log_level::INFO, CLIENT, "Client %s:%d timeout",
-										inet_ntoa(servers[serverFd]->getClientIPv4Address(clientFd)),
-										ntohs(servers[serverFd]->getClientPortNumber(clientFd)));
-				servers[serverFd]->createAndSendErrorResponse(REQUEST_TIMEOUT, clientFd);
-				handleClientDisconnection(it);
-			}
-		}
+				exitStatus = EXIT_FAILURE;
+				shutdownFlag = 1;
+				kill(getpid(), SIGINT); // get the main thread out of sigsuspend
+			} });
 	}
-}
 
-void ServerManager::handleReadyToRead(std::list<pollfd>::iterator &it)
-{
-	if (servers.find(it->fd) != servers.end()) // if the fd is server fd, accept new connection
+	sig_atomic_t metricsSeen = metricsRequests;
+	while (!shutdownFlag)
 	{
-		int serverFd = it->fd;
-		int clientFd = servers[serverFd]->acceptNewConnection();
-		if (clientFd >= 0)
+		sigsuspend(&oldSet);
+		if (metricsRequests != metricsSeen)
 		{
-			pollfds.push_back({clientFd, POLLIN, 0}); // add the new client fd to poll fd
-			clientToServerMap[clientFd] = serverFd;
-			clientLastActiveTime[clientFd] = std::chrono::steady_clock::now();
+			metricsSeen = metricsRequests;
+			for (std::unique_ptr<Worker> &worker : workers)
+				worker->wakeUp();
 		}
 	}
-	else // if the fd is client fd, parse the request and build response
-	{
-		int clientFd = it->fd;
-		int serverFd = clientToServerMap[clientFd];
-		Server::RequestStatus requestStatus = servers[serverFd]->receiveRequest(clientFd); // return REQUEST_CLIENT_DISCONNECT or READY_TO_WRITE or BODY_IN_CHUNK
-		clientLastActiveTime[clientFd] = std::chrono::steady_clock::now();
-		if (requestStatus == Server::READY_TO_WRITE)
-			*it = {clientFd, POLLOUT, 0};
-		else if (requestStatus == Server::REQUEST_CLIENT_DISCONNECT)
-			handleClientDisconnection(it);
-	}
-}
+	pthread_sigmask(SIG_SETMASK, &oldSet, nullptr);
 
-void ServerManager::handleReadyToWrite(std::list<pollfd>::iterator &it)
-{
-	int clientFd = it->fd;
-	int serverFd = clientToServerMap[clientFd];
-	Server::ResponseStatus responseStatus = servers[serverFd]->sendResponse(clientFd); // return RESPONSE_DISCONNECT_CLIENT or KEEP_ALIVE or RESPONSE_IN_CHUNK
-	clientLastActiveTime[clientFd] = std::chrono::steady_clock::now();
-	if (responseStatus == Server::KEEP_ALIVE)
-		*it = {clientFd, POLLIN, 0};
-	else if (responseStatus == Server::RESPONSE_DISCONNECT_CLIENT)
-		handleClientDisconnection(it);
-}
-
-// if client's connection is closed, remove the client, close fd and remove fd
-void ServerManager::handleClientDisconnection(std::list<pollfd>::iterator &it)
-{
-	int clientFd = it->fd;
-	int serverFd = clientToServerMap[clientFd];
-	servers[serverFd]->removeClient(clientFd);
-	close(clientFd);
-	clientToServerMap.erase(clientFd);
-	clientLastActiveTime.erase(clientFd);
-	it = pollfds.erase(it);
-	it--;
+	for (std::unique_ptr<Worker> &worker : workers)
+		worker->wakeUp();
+	for (std::thread &thread : workerThreads)
+		thread.join();
+	workerThreads.clear();
 }
 
+// only used when the workers are not running anymore, e.g. on start up failure or from the seg fault handler
 void ServerManager::cleanUpForServerShutdown(HttpStatusCode const &statusCode)
 {
-	for (const std::pair<const int, int> &clientToServerPair : clientToServerMap) // send error response to all clients
-		servers[clientToServerPair.second]->createAndSendErrorResponse(statusCode, clientToServerPair.first);
-	for (const pollfd &fd : pollfds) // close all pollfds
-		close(fd.fd);
-	for (std::pair<const int, std::unique_ptr<Server>> &server : servers)
-	{
-		Logger::log(e_log_level::INFO, SERVER, "Server %s:%d shut down", server.second->getHost().c_str(), server.second->getPort());
-		server.second.reset();
-	}
-}
-
-const char *ServerManager::PollException::what() const throw()
-{
-	return "ServerManager::poll() failed";
-}
-
-const char *ServerManager::ReventErrorFlagException::what() const throw()
-{
-	return "ServerManager::error flag in revent";
+	for (std::unique_ptr<Worker> &worker : workers)
+		worker->cleanUpForServerShutdown(statusCode);
 }
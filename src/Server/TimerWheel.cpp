@@ -0,0 +1,125 @@
+#include "TimerWheel.hpp"
+
+TimerWheel::TimerWheel() : startTime(std::chrono::steady_clock::now()), currentTick(0), timerCount(0)
+{
+	for (size_t level = 0; level < TIMER_WHEEL_LEVELS; ++level)
+		levels[level].resize(levelSize(level));
+}
+
+// number of ticks covered by one slot of the level, as a power of two
+size_t TimerWheel::levelShift(size_t const &level)
+{
+	return (level == 0 ? 0 : TIMER_WHEEL_ROOT_BITS + (level - 1) * TIMER_WHEEL_LEVEL_BITS);
+}
+
+size_t TimerWheel::levelSize(size_t const &level)
+{
+	return (static_cast<size_t>(1) << (level == 0 ? TIMER_WHEEL_ROOT_BITS : TIMER_WHEEL_LEVEL_BITS));
+}
+
+uint64_t TimerWheel::toTick(std::chrono::steady_clock::time_point const &time) const
+{
+	return (std::chrono::duration_cast<std::chrono::milliseconds>(time - startTime).count() / TIMER_WHEEL_TICK_MS);
+}
+
+// move the entry into the slot matching its distance from the current tick
+void TimerWheel::place(std::list<TimerEntry> &from, std::list<TimerEntry>::iterator const &it)
+{
+	uint64_t maxDistance = static_cast<uint64_t>(1) << (levelShift(TIMER_WHEEL_LEVELS - 1) + TIMER_WHEEL_LEVEL_BITS);
+	if (it->expiryTick < currentTick)
+		it->expiryTick = currentTick;
+	if (it->expiryTick - currentTick >= maxDistance) // further than the wheel can hold, expire at its far end
+		it->expiryTick = currentTick + maxDistance - 1;
+
+	uint64_t distance = it->expiryTick - currentTick;
+	size_t level = 0;
+	while (level + 1 < TIMER_WHEEL_LEVELS && distance >= (static_cast<uint64_t>(1) << levelShift(level + 1)))
+		++level;
+	it->level = level;
+	it->slot = (it->expiryTick >> levelShift(level)) & (levelSize(level) - 1);
+	std::list<TimerEntry> &to = levels[level][it->slot];
+	to.splice(to.end(), from, it); // splicing keeps the iterator held by the handle valid
+}
+
+// the lower level finished a turn, spread this level's current slot over the levels below
+void TimerWheel::cascade(size_t const &level)
+{
+	size_t slot = (currentTick >> levelShift(level)) & (levelSize(level) - 1);
+	std::list<TimerEntry> &entries = levels[level][slot];
+	while (!entries.empty())
+		place(entries, entries.begin());
+}
+
+void TimerWheel::schedule(TimerHandle &handle, int const &fd, size_t const &timeoutMs)
+{
+	cancel(handle);
+	uint64_t ticks = (timeoutMs + TIMER_WHEEL_TICK_MS - 1) / TIMER_WHEEL_TICK_MS;
+	std::list<TimerEntry> pending;
+	pending.push_back({fd, currentTick + (ticks ? ticks : 1), 0, 0, &handle});
+	handle.entry = pending.begin();
+	handle.active = true;
+	place(pending, pending.begin());
+	++timerCount;
+}
+
+void TimerWheel::cancel(TimerHandle &handle)
+{
+	if (!handle.active)
+		return;
+	levels[handle.entry->level][handle.entry->slot].erase(handle.entry);
+	handle.active = false;
+	--timerCount;
+}
+
+void TimerWheel::advance(std::chrono::steady_clock::time_point const &now, std::vector<int> &expiredFds)
+{
+	uint64_t nowTick = toTick(now);
+	if (timerCount == 0) // nothing to expire, just catch up
+	{
+		if (nowTick > currentTick)
+			currentTick = nowTick;
+		return;
+	}
+	while (currentTick < nowTick)
+	{
+		++currentTick;
+		for (size_t level = TIMER_WHEEL_LEVELS - 1; level > 0; --level) // cascade from the top, only when every level below wrapped
+		{
+			if ((currentTick & ((static_cast<uint64_t>(1) << levelShift(level)) - 1)) == 0)
+				cascade(level);
+		}
+		std::list<TimerEntry> &expired = levels[0][currentTick & (levelSize(0) - 1)];
+		for (TimerEntry &entry : expired)
+		{
+			expiredFds.push_back(entry.fd);
+			entry.handle->active = false;
+			--timerCount;
+		}
+		expired.clear();
+		if (timerCount == 0)
+		{
+			currentTick = nowTick;
+			break;
+		}
+	}
+}
+
+// sleep until the next occupied root slot, or until the next cascade
+int TimerWheel::getNextTimeoutMs() const
+{
+	if (timerCount == 0)
+		return (-1);
+	size_t rootSize = levelSize(0);
+	uint64_t ticksToCascade = rootSize - (currentTick & (rootSize - 1));
+	uint64_t ticks = 1;
+	while (ticks < ticksToCascade && levels[0][(currentTick + ticks) & (rootSize - 1)].empty())
+		++ticks;
+	uint64_t elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count();
+	uint64_t wakeUpMs = (currentTick + ticks) * TIMER_WHEEL_TICK_MS;
+	return (wakeUpMs > elapsedMs ? static_cast<int>(wakeUpMs - elapsedMs) : 0);
+}
+
+size_t TimerWheel::size() const
+{
+	return (timerCount);
+}
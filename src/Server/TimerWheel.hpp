@@ -0,0 +1,62 @@
+#ifndef TIMERWHEEL_HPP
+#define TIMERWHEEL_HPP
+
+#include <list>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+#include "../defines.hpp"
+
+/* Hierarchical timing wheel for the client deadlines.
+ * Level 0 has one slot per tick, every higher level covers a whole turn of the level below it and is
+ * cascaded down when that turn is over. Scheduling and cancelling are O(1), and advancing the wheel
+ * only touches the timers that expire (plus one cascade per turn).
+ */
+class TimerWheel
+{
+public:
+	struct TimerEntry;
+
+	// owned by the caller, must stay at the same address while the timer is active
+	struct TimerHandle
+	{
+		bool active;
+		std::list<TimerEntry>::iterator entry;
+
+		TimerHandle() : active(false) {}
+	};
+
+	struct TimerEntry
+	{
+		int fd;
+		uint64_t expiryTick;
+		size_t level;
+		size_t slot;
+		TimerHandle *handle;
+	};
+
+private:
+	std::chrono::steady_clock::time_point startTime;
+	uint64_t currentTick;
+	size_t timerCount;
+	std::vector<std::list<TimerEntry>> levels[TIMER_WHEEL_LEVELS];
+
+	static size_t levelShift(size_t const &level);
+	static size_t levelSize(size_t const &level);
+	uint64_t toTick(std::chrono::steady_clock::time_point const &time) const;
+	void place(std::list<TimerEntry> &from, std::list<TimerEntry>::iterator const &it);
+	void cascade(size_t const &level);
+
+public:
+	TimerWheel();
+
+	void schedule(TimerHandle &handle, int const &fd, size_t const &timeoutMs);
+	void cancel(TimerHandle &handle);
+	void advance(std::chrono::steady_clock::time_point const &now, std::vector<int> &expiredFds);
+	int getNextTimeoutMs() const; // how long the event loop may sleep, -1 if there is no timer
+	size_t size() const;
+};
+
+#endif
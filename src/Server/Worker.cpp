@@ -0,0 +1,413 @@
+#include "Worker.hpp"
+
+extern volatile sig_atomic_t shutdownFlag;
+extern volatile sig_atomic_t metricsRequests;
+
+Worker::Worker(int const &id, std::vector<ConfigData> const &serverConfigs, GlobalConfig const &globalConfig, bool const &reusePort,
+			   AdmissionControl &admissionControl)
+		: id(id), serverConfigs(serverConfigs), globalConfig(globalConfig), reusePort(reusePort), admissionControl(admissionControl),
+		  acceptPaused(false), wakeUpPipe{-1, -1}, metricsLogged(metricsRequests)
+{
+}
+
+Worker::~Worker()
+{
+	if (wakeUpPipe[READ_END] >= 0)
+		close(wakeUpPipe[READ_END]);
+	if (wakeUpPipe[WRITE_END] >= 0)
+		close(wakeUpPipe[WRITE_END]);
+}
+
+// create everything the loop needs, done before any worker starts so that a bind failure stops the whole server
+void Worker::setUpWorker()
+{
+	createEventBackend();
+	createWakeUpPipe();
+	createServers();
+}
+
+int Worker::runWorker()
+{
+	try
+	{
+		OpenFileCache::getInstance().configure(globalConfig.getOpenFileCache(), globalConfig.getOpenFileCacheValidMs(),
+											   globalConfig.getOpenFileCacheErrors());
+		ContentCache::getInstance().configure(globalConfig.getContentCacheSize(), globalConfig.getContentCacheMaxFileSize());
+		startServerLoop();
+		cleanUpForServerShutdown(HttpStatusCode::INTERNAL_SERVER_ERROR);
+		metrics.log(id);
+		return EXIT_SUCCESS;
+	}
+	catch (std::exception &e)
+	{
+		Logger::log(e_log_level::ERROR, ERROR_MESSAGE, "Worker %d: Internal server error - %s", id, e.what());
+		cleanUpForServerShutdown(HttpStatusCode::INTERNAL_SERVER_ERROR);
+		return EXIT_FAILURE;
+	}
+}
+
+// called from another thread to get the worker out of its wait once shutdownFlag is set or metrics are asked for
+void Worker::wakeUp()
+{
+	if (wakeUpPipe[WRITE_END] >= 0 && write(wakeUpPipe[WRITE_END], "x", 1) < 0)
+		Logger::log(e_log_level::ERROR, SERVER, "Worker %d: fails to be woken up", id);
+}
+
+void Worker::createWakeUpPipe()
+{
+	if (pipe(wakeUpPipe) < 0)
+		throw WakeUpPipeException();
+	for (int fd : wakeUpPipe)
+	{
+		if (fcntl(fd, F_SETFL, O_NONBLOCK) < 0 || fcntl(fd, F_SETFD, FD_CLOEXEC) < 0)
+			throw WakeUpPipeException();
+	}
+	eventBackend->addFd(wakeUpPipe[READ_END], EventBackend::WANT_READ, 0);
+}
+
+void Worker::createEventBackend()
+{
+	switch (globalConfig.getEventEngine())
+	{
+#ifdef __linux__
+	case EventEngine::ENGINE_EPOLL:
+		eventBackend = std::make_unique<EpollBackend>();
+		break;
+#endif
+	default:
+		eventBackend = std::make_unique<PollBackend>();
+	}
+	Logger::log(e_log_level::INFO, SERVER, "Worker %d: Event engine: %s", id, eventBackend->getName());
+}
+
+void Worker::createServers()
+{
+	for (const ConfigData &config : serverConfigs)
+	{
+		Server *existingServer = findServer(config.getServerHost(), config.getServerPort());
+
+		if (existingServer == nullptr) // if it is a new server
+		{
+			std::unique_ptr<Server> server = std::make_unique<Server>(config);
+			server->setUpServerSocket(reusePort);
+			Logger::log(e_log_level::INFO, SERVER, "Worker %d: Server created - Host: %s, Port: %d, Server Name: %s",
+									id,
+									server->getHost().c_str(),
+									server->getPort(),
+									config.getServerName().c_str());
+			server->setConnectionLimiter(admissionControl.getListenerLimiter(config.getServerHost(), config.getServerPort()));
+			int serverFd = server->getServerFd();
+			if (!connections.addListener(serverFd, *server))
+			{
+				close(serverFd);
+				throw ConnectionTableException();
+			}
+			servers.push_back(std::move(server));
+			eventBackend->addFd(serverFd, EventBackend::WANT_READ, connections.find(serverFd)->generation); // watch the server socket for new connections
+		}
+		else
+		{
+			existingServer->appendConfig(config);
+			Logger::log(e_log_level::INFO, SERVER, "Configuration of Server Name %s added to Server %s:%d",
+									config.getServerName().c_str(),
+									config.getServerHost().c_str(),
+									config.getServerPort());
+		}
+	}
+}
+
+Server *Worker::findServer(const std::string &host, const int &port) const
+{
+	for (const std::unique_ptr<Server> &server : servers)
+	{
+		if (server->getHost() == host && server->getPort() == port)
+			return server.get();
+	}
+	return nullptr;
+}
+
+// start the main server loop
+void Worker::startServerLoop()
+{
+	while (!shutdownFlag)
+	{
+		handlePoll();
+		for (const EventBackend::Event &event : eventBackend->getEvents()) // only the fds that are ready are reported
+		{
+			if (shutdownFlag)
+				break;
+			handleEvent(event);
+		}
+		if (!shutdownFlag)
+			checkTimers(); // only after the round, an fd closed here must not be reused by an accept while its old events are pending
+		if (metricsLogged != metricsRequests) // SIGUSR1, the counters are only read by the worker's own thread
+		{
+			metricsLogged = metricsRequests;
+			metrics.log(id);
+		}
+	}
+}
+
+// wait for the event backend until the next client deadline, then move the wheel on so the events schedule from the current time
+void Worker::handlePoll()
+{
+	int ready = eventBackend->waitForEvents(timerWheel.getNextTimeoutMs());
+
+	if (shutdownFlag == 1)
+		return;
+
+	if (ready < 0 && errno != EINTR)
+		throw PollException();
+	timerWheel.advance(std::chrono::steady_clock::now(), expiredFds);
+}
+
+void Worker::handleEvent(EventBackend::Event const &event)
+{
+	if (event.fd == wakeUpPipe[READ_END]) // woken up by the manager, the loop condition handles the rest
+	{
+		char buf[64];
+		while (read(wakeUpPipe[READ_END], buf, sizeof(buf)) > 0)
+			;
+		return;
+	}
+	ConnectionTable::Connection *connection = connections.find(event.fd);
+	if (connection == nullptr || connection->generation != event.generation)
+		return; // the client was already disconnected earlier in this round, maybe its fd went to a new client since
+	if (connection->type == ConnectionTable::LISTENER_SLOT)
+		handleNewConnection(*connection->server);
+	else if (event.readable)
+		handleReadyToRead(*connection);
+	else if (event.writable)
+		handleReadyToWrite(*connection);
+	else if (event.hangup || event.error)
+	{
+		Logger::log(e_log_level::INFO, CLIENT, "Client %s:%d disconnect",
+								inet_ntoa(connection->client->getIPv4Address()),
+								ntohs(connection->client->getPortNumber()));
+		handleClientDisconnection(*connection);
+	}
+	else
+		throw ReventErrorFlagException();
+}
+
+/* Only the connections whose deadline passed are visited, an expired listener ends a pause of the accepts.
+ * A timer that was armed again by the events of the round (or belongs to a new client on a reused fd) is left alone.
+ */
+void Worker::checkTimers()
+{
+	for (int fd : expiredFds)
+	{
+		ConnectionTable::Connection *connection = connections.find(fd);
+		if (connection == nullptr || connection->timer.active)
+			continue;
+		if (connection->type == ConnectionTable::LISTENER_SLOT)
+			resumeAccepting();
+		else
+			handleClientTimeout(*connection);
+	}
+	expiredFds.clear();
+}
+
+// a client waiting for (more of) a request gets a 408, an idle keep-alive or stalled reader is just closed
+void Worker::handleClientTimeout(ConnectionTable::Connection &connection)
+{
+	Logger::log(e_log_level::INFO, CLIENT, "Client %s:%d timeout",
+							inet_ntoa(connection.client->getIPv4Address()),
+							ntohs(connection.client->getPortNumber()));
+	if (connection.timeout == CLIENT_HEADER_TIMEOUT || connection.timeout == CLIENT_BODY_TIMEOUT)
+		connection.server->createAndSendErrorResponse(REQUEST_TIMEOUT, *connection.client);
+	handleClientDisconnection(connection);
+}
+
+void Worker::armClientTimer(ConnectionTable::Connection &connection, ClientTimeout const &timeout)
+{
+	connection.timeout = timeout;
+	timerWheel.schedule(connection.timer, connection.client->getFd(), connection.server->getTimeoutMs(timeout));
+}
+
+// drain the accept queue up to the budget, so a connection storm does not wait one loop round per connection
+void Worker::handleNewConnection(Server &server)
+{
+	size_t accepted = 0;
+	Server::AcceptStatus acceptStatus = Server::ACCEPTED;
+	while (accepted < static_cast<size_t>(globalConfig.getAcceptBudget()))
+	{
+		std::unique_ptr<Client> client;
+		if ((acceptStatus = server.acceptNewConnection(client)) != Server::ACCEPTED)
+			break;
+		++accepted;
+		admitNewConnection(server, client);
+	}
+	metrics.recordAcceptWakeUp(accepted);
+	if (acceptStatus == Server::ACCEPT_QUEUE_EMPTY)
+		++metrics.acceptQueueDrained;
+	else if (acceptStatus == Server::ACCEPT_OUT_OF_FDS)
+		pauseAccepting();
+	else if (acceptStatus == Server::ACCEPT_FAILED)
+		++metrics.acceptErrors;
+	else
+		++metrics.acceptBudgetExhausted; // the listener stays readable, the rest is accepted in the next round
+}
+
+// over the global or the server's max_connections the client gets the prebuilt 503 and is closed right away
+void Worker::admitNewConnection(Server &server, std::unique_ptr<Client> &client)
+{
+	int clientFd = client->getFd();
+	if (!admissionControl.admit(server.getConnectionLimiter()))
+	{
+		admissionControl.shed(clientFd);
+		close(clientFd);
+		++metrics.shedConnections;
+		return;
+	}
+	ConnectionTable::Connection *connection = connections.addClient(server, client);
+	if (connection == nullptr) // the fd is beyond the table
+	{
+		Logger::log(e_log_level::ERROR, SERVER, "Worker %d: no connection slot for fd %d", id, clientFd);
+		admissionControl.release(server.getConnectionLimiter());
+		close(clientFd);
+		return;
+	}
+	eventBackend->addFd(clientFd, EventBackend::WANT_READ, connection->generation); // watch the new client fd
+	armClientTimer(*connection, CLIENT_HEADER_TIMEOUT);
+	metrics.openConnections = connections.getClientCount();
+}
+
+/* Out of fds: the pending connections cannot be accepted, and a level-triggered listener would wake the loop
+ * up again right away. Stop watching the listeners until a client is closed or ACCEPT_PAUSE_MS passed.
+ */
+void Worker::pauseAccepting()
+{
+	if (acceptPaused)
+		return;
+	acceptPaused = true;
+	++metrics.acceptPauses;
+	for (std::unique_ptr<Server> &server : servers)
+	{
+		int serverFd = server->getServerFd();
+		eventBackend->removeFd(serverFd);
+		timerWheel.schedule(connections.find(serverFd)->timer, serverFd, ACCEPT_PAUSE_MS);
+	}
+}
+
+void Worker::resumeAccepting()
+{
+	if (!acceptPaused)
+		return;
+	acceptPaused = false;
+	for (std::unique_ptr<Server> &server : servers)
+	{
+		int serverFd = server->getServerFd();
+		timerWheel.cancel(connections.find(serverFd)->timer);
+		eventBackend->addFd(serverFd, EventBackend::WANT_READ, connections.find(serverFd)->generation);
+	}
+}
+
+// parse the request and build response
+void Worker::handleReadyToRead(ConnectionTable::Connection &connection)
+{
+	handleRequestStatus(connection, connection.server->receiveRequest(*connection.client));
+}
+
+// what the connection waits for next while its request is received
+void Worker::handleRequestStatus(ConnectionTable::Connection &connection, Server::RequestStatus const &requestStatus)
+{
+	if (requestStatus == Server::READY_TO_WRITE || requestStatus == Server::INTERIM_RESPONSE_PENDING)
+	{
+		eventBackend->modifyFd(connection.client->getFd(), EventBackend::WANT_WRITE, connection.generation);
+		armClientTimer(connection, SEND_TIMEOUT);
+	}
+	else if (requestStatus == Server::BODY_IN_CHUNK)
+		armClientTimer(connection, CLIENT_BODY_TIMEOUT);
+	else if (requestStatus == Server::HEADER_INCOMPLETE && connection.timeout != CLIENT_HEADER_TIMEOUT)
+		armClientTimer(connection, CLIENT_HEADER_TIMEOUT); // kept running over the reads, a slow head does not extend it
+	else if (requestStatus == Server::REQUEST_CLIENT_DISCONNECT)
+		handleClientDisconnection(connection);
+}
+
+void Worker::handleReadyToWrite(ConnectionTable::Connection &connection)
+{
+	if (!connection.client->hasResponse()) // the rest of a 100 Continue, the body is read after it
+	{
+		Server::RequestStatus requestStatus = connection.server->sendInterimResponse(*connection.client);
+		if (requestStatus == Server::BODY_IN_CHUNK)
+			eventBackend->modifyFd(connection.client->getFd(), EventBackend::WANT_READ, connection.generation);
+		handleRequestStatus(connection, requestStatus);
+		return;
+	}
+	Server::ResponseStatus responseStatus = connection.server->sendResponse(*connection.client); // return RESPONSE_DISCONNECT_CLIENT or KEEP_ALIVE or RESPONSE_IN_CHUNK
+	if (responseStatus == Server::KEEP_ALIVE)
+	{
+		eventBackend->modifyFd(connection.client->getFd(), EventBackend::WANT_READ, connection.generation);
+		armClientTimer(connection, KEEPALIVE_TIMEOUT);
+		if (!connection.client->getInputBuffer().empty()) // a pipelined request already arrived, its socket may not become readable again
+			handleReadyToRead(connection);
+	}
+	else if (responseStatus == Server::RESPONSE_IN_CHUNK)
+		armClientTimer(connection, SEND_TIMEOUT);
+	else if (responseStatus == Server::RESPONSE_DISCONNECT_CLIENT)
+		handleClientDisconnection(connection);
+}
+
+// if client's connection is closed, remove the client, close fd and stop watching it
+void Worker::handleClientDisconnection(ConnectionTable::Connection &connection)
+{
+	int clientFd = connection.client->getFd();
+	Logger::log(e_log_level::INFO, CLIENT, "Client %s:%d is removed",
+							inet_ntoa(connection.client->getIPv4Address()),
+							ntohs(connection.client->getPortNumber()));
+	timerWheel.cancel(connection.timer);
+	eventBackend->removeFd(clientFd);
+	close(clientFd);
+	admissionControl.release(connection.server->getConnectionLimiter());
+	connections.release(clientFd);
+	metrics.openConnections = connections.getClientCount();
+	resumeAccepting(); // an fd was freed
+}
+
+void Worker::cleanUpForServerShutdown(HttpStatusCode const &statusCode)
+{
+	for (int clientFd : connections.getClientFds()) // send error response to all clients and close their fds
+	{
+		ConnectionTable::Connection &connection = *connections.find(clientFd);
+		connection.server->createAndSendErrorResponse(statusCode, *connection.client);
+		timerWheel.cancel(connection.timer);
+		close(clientFd);
+		admissionControl.release(connection.server->getConnectionLimiter());
+		connections.release(clientFd);
+	}
+	for (std::unique_ptr<Server> &server : servers)
+	{
+		timerWheel.cancel(connections.find(server->getServerFd())->timer);
+		close(server->getServerFd());
+		connections.release(server->getServerFd());
+		Logger::log(e_log_level::INFO, SERVER, "Server %s:%d shut down", server->getHost().c_str(), server->getPort());
+		server.reset();
+	}
+	servers.clear();
+}
+
+int const &Worker::getId() const
+{
+	return (id);
+}
+
+const char *Worker::PollException::what() const throw()
+{
+	return "Worker::event backend wait failed";
+}
+
+const char *Worker::ReventErrorFlagException::what() const throw()
+{
+	return "Worker::error flag in event";
+}
+
+const char *Worker::WakeUpPipeException::what() const throw()
+{
+	return "Worker::Fail to create wake up pipe";
+}
+
+const char *Worker::ConnectionTableException::what() const throw()
+{
+	return "Worker::Server socket does not fit in the connection table";
+}
@@ -0,0 +1,109 @@
+#ifndef WORKER_HPP
+#define WORKER_HPP
+
+#include <vector>
+#include <unordered_map>
+#include <string>
+#include <stdexcept>
+#include <csignal>
+#include <iostream>
+#include <unistd.h>
+#include <fcntl.h>
+#include <chrono>
+#include <memory>
+#include <cerrno>
+
+#include "Server.hpp"
+#include "EventBackend.hpp"
+#include "PollBackend.hpp"
+#include "EpollBackend.hpp"
+#include "TimerWheel.hpp"
+#include "ConnectionTable.hpp"
+#include "Metrics.hpp"
+#include "AdmissionControl.hpp"
+#include "../Config/ConfigParser.hpp"
+#include "../Utils/OpenFileCache.hpp"
+#include "../Utils/ContentCache.hpp"
+
+/* One event loop. Every worker owns its event backend, its own listening socket for every Server
+ * and its own client table, so workers running on different threads never share state.
+ */
+class Worker
+{
+
+private:
+	int id;
+	std::vector<ConfigData> const &serverConfigs;
+	GlobalConfig const &globalConfig;
+	bool reusePort;
+	AdmissionControl &admissionControl;
+	bool acceptPaused;
+	std::unique_ptr<EventBackend> eventBackend;
+	int wakeUpPipe[2];
+	sig_atomic_t metricsLogged; // metricsRequests when the counters were last logged
+	std::vector<std::unique_ptr<Server>> servers;
+	ConnectionTable connections;
+	TimerWheel timerWheel;
+	std::vector<int> expiredFds; // found when the wheel was advanced after the wait, handled after that round's events
+	Metrics metrics;
+
+	void createEventBackend();
+	void createWakeUpPipe();
+	void createServers();
+	Server *findServer(const std::string &host, const int &port) const;
+	void startServerLoop();
+	void handlePoll();
+	void handleEvent(EventBackend::Event const &event);
+	void checkTimers();
+	void armClientTimer(ConnectionTable::Connection &connection, ClientTimeout const &timeout);
+	void handleClientTimeout(ConnectionTable::Connection &connection);
+	void handleNewConnection(Server &server);
+	void admitNewConnection(Server &server, std::unique_ptr<Client> &client);
+	void pauseAccepting();
+	void resumeAccepting();
+	void handleReadyToRead(ConnectionTable::Connection &connection);
+	void handleRequestStatus(ConnectionTable::Connection &connection, Server::RequestStatus const &requestStatus);
+	void handleReadyToWrite(ConnectionTable::Connection &connection);
+	void handleClientDisconnection(ConnectionTable::Connection &connection);
+
+	Worker(const Worker &) = delete;
+	Worker &operator=(const Worker &) = delete;
+
+public:
+	Worker(int const &id, std::vector<ConfigData> const &serverConfigs, GlobalConfig const &globalConfig, bool const &reusePort,
+		   AdmissionControl &admissionControl);
+	~Worker();
+
+	void setUpWorker();
+	int runWorker();
+	void wakeUp();
+	void cleanUpForServerShutdown(HttpStatusCode const &statusCode);
+
+	int const &getId() const;
+
+	class PollException : public std::exception
+	{
+	public:
+		virtual const char *what() const throw();
+	};
+
+	class ReventErrorFlagException : public std::exception
+	{
+	public:
+		virtual const char *what() const throw();
+	};
+
+	class WakeUpPipeException : public std::exception
+	{
+	public:
+		virtual const char *what() const throw();
+	};
+
+	class ConnectionTableException : public std::exception
+	{
+	public:
+		virtual const char *what() const throw();
+	};
+};
+
+#endif
@@ -0,0 +1,170 @@
+#include "ByteScanner.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define BYTE_SCANNER_X86
+#include <immintrin.h>
+#endif
+
+namespace
+{
+	typedef size_t (*FindFunction)(const unsigned char *, size_t, const unsigned char *, size_t);
+
+	// the bytes of the needle between its first and last one, those two are already known to match
+	bool middleMatches(const unsigned char *candidate, const unsigned char *needle, size_t needleSize)
+	{
+		return (needleSize <= 2 || std::memcmp(candidate + 1, needle + 1, needleSize - 2) == 0);
+	}
+
+	size_t findScalar(const unsigned char *haystack, size_t size, const unsigned char *needle, size_t needleSize)
+	{
+		size_t from = 0;
+		while (from + needleSize <= size)
+		{
+			const void *hit = std::memchr(haystack + from, needle[0], size - needleSize + 1 - from);
+			if (hit == nullptr)
+				return (ByteScanner::npos);
+			size_t position = static_cast<const unsigned char *>(hit) - haystack;
+			if (std::memcmp(haystack + position, needle, needleSize) == 0)
+				return (position);
+			from = position + 1;
+		}
+		return (ByteScanner::npos);
+	}
+
+	// the positions from 'from' on that the vector loop left, fewer than one vector
+	size_t findTail(const unsigned char *haystack, size_t size, const unsigned char *needle, size_t needleSize, size_t from)
+	{
+		size_t position = findScalar(haystack + from, size - from, needle, needleSize);
+		return (position == ByteScanner::npos ? position : from + position);
+	}
+
+#ifdef BYTE_SCANNER_X86
+	/* Four vectors per round, their candidate masks are or-ed so a round without any candidate
+	 * costs a single branch. Candidates are then checked vector by vector, in order.
+	 */
+	__attribute__((target("sse2"))) size_t findSse2(const unsigned char *haystack, size_t size, const unsigned char *needle, size_t needleSize)
+	{
+		const __m128i first = _mm_set1_epi8(static_cast<char>(needle[0]));
+		const __m128i last = _mm_set1_epi8(static_cast<char>(needle[needleSize - 1]));
+		const size_t vector = sizeof(__m128i);
+		size_t i = 0;
+		for (; i + needleSize - 1 + 4 * vector <= size; i += 4 * vector)
+		{
+			__m128i candidates[4];
+			for (size_t v = 0; v < 4; ++v)
+			{
+				__m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i *>(haystack + i + v * vector));
+				__m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i *>(haystack + i + v * vector + needleSize - 1));
+				candidates[v] = _mm_and_si128(_mm_cmpeq_epi8(first, blockFirst), _mm_cmpeq_epi8(last, blockLast));
+			}
+			__m128i any = _mm_or_si128(_mm_or_si128(candidates[0], candidates[1]), _mm_or_si128(candidates[2], candidates[3]));
+			if (_mm_movemask_epi8(any) == 0)
+				continue;
+			for (size_t v = 0; v < 4; ++v)
+			{
+				unsigned int mask = _mm_movemask_epi8(candidates[v]);
+				while (mask != 0)
+				{
+					size_t position = i + v * vector + __builtin_ctz(mask);
+					if (middleMatches(haystack + position, needle, needleSize))
+						return (position);
+					mask &= mask - 1;
+				}
+			}
+		}
+		return (findTail(haystack, size, needle, needleSize, i));
+	}
+
+	__attribute__((target("avx2"))) size_t findAvx2(const unsigned char *haystack, size_t size, const unsigned char *needle, size_t needleSize)
+	{
+		const __m256i first = _mm256_set1_epi8(static_cast<char>(needle[0]));
+		const __m256i last = _mm256_set1_epi8(static_cast<char>(needle[needleSize - 1]));
+		const size_t vector = sizeof(__m256i);
+		size_t i = 0;
+		for (; i + needleSize - 1 + 2 * vector <= size; i += 2 * vector)
+		{
+			__m256i candidates[2];
+			for (size_t v = 0; v < 2; ++v)
+			{
+				__m256i blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(haystack + i + v * vector));
+				__m256i blockLast = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(haystack + i + v * vector + needleSize - 1));
+				candidates[v] = _mm256_and_si256(_mm256_cmpeq_epi8(first, blockFirst), _mm256_cmpeq_epi8(last, blockLast));
+			}
+			if (_mm256_testz_si256(_mm256_or_si256(candidates[0], candidates[1]), _mm256_set1_epi8(-1)))
+				continue;
+			for (size_t v = 0; v < 2; ++v)
+			{
+				unsigned int mask = _mm256_movemask_epi8(candidates[v]);
+				while (mask != 0)
+				{
+					size_t position = i + v * vector + __builtin_ctz(mask);
+					if (middleMatches(haystack + position, needle, needleSize))
+						return (position);
+					mask &= mask - 1;
+				}
+			}
+		}
+		return (findTail(haystack, size, needle, needleSize, i));
+	}
+#endif
+
+	FindFunction getFindFunction(ByteScanner::Kernel const &kernel)
+	{
+#ifdef BYTE_SCANNER_X86
+		if (kernel == ByteScanner::AVX2)
+			return (findAvx2);
+		if (kernel == ByteScanner::SSE2)
+			return (findSse2);
+#else
+		(void)kernel;
+#endif
+		return (findScalar);
+	}
+}
+
+bool ByteScanner::isSupported(Kernel const &kernel)
+{
+#ifdef BYTE_SCANNER_X86
+	if (kernel == AVX2)
+		return (__builtin_cpu_supports("avx2"));
+	if (kernel == SSE2)
+		return (__builtin_cpu_supports("sse2"));
+#endif
+	return (kernel == SCALAR);
+}
+
+ByteScanner::Kernel ByteScanner::getBestKernel()
+{
+	if (isSupported(AVX2))
+		return (AVX2);
+	if (isSupported(SSE2))
+		return (SSE2);
+	return (SCALAR);
+}
+
+const char *ByteScanner::getKernelName(Kernel const &kernel)
+{
+	if (kernel == AVX2)
+		return ("avx2");
+	if (kernel == SSE2)
+		return ("sse2");
+	return ("scalar");
+}
+
+// with the given kernel, which has to be supported by the CPU
+size_t ByteScanner::find(Kernel const &kernel, const void *haystack, size_t const &size, const void *needle, size_t const &needleSize)
+{
+	if (needleSize == 0)
+		return (0);
+	if (needleSize > size)
+		return (npos);
+	return (getFindFunction(kernel)(static_cast<const unsigned char *>(haystack), size,
+									static_cast<const unsigned char *>(needle), needleSize));
+}
+
+// the position of the first needle in haystack, npos if there is none
+size_t ByteScanner::find(const void *haystack, size_t const &size, const void *needle, size_t const &needleSize)
+{
+	static const Kernel kernel = getBestKernel();
+	return (find(kernel, haystack, size, needle, needleSize));
+}
@@ -0,0 +1,32 @@
+#ifndef BYTESCANNER_HPP
+#define BYTESCANNER_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+/* Substring search over raw bytes (request heads, bodies), vectorized where the CPU allows it.
+ * The SIMD kernels compare the first and the last byte of the needle against 16 (SSE2) or 32 (AVX2)
+ * positions at once and only look at the bytes in between where both match. The kernel is
+ * picked once at runtime: AVX2 if the CPU has it, SSE2 on any other x86-64, a memchr() based
+ * scalar search elsewhere.
+ */
+namespace ByteScanner
+{
+	enum Kernel
+	{
+		SCALAR,
+		SSE2,
+		AVX2
+	};
+
+	const size_t npos = std::string::npos;
+
+	size_t find(const void *haystack, size_t const &size, const void *needle, size_t const &needleSize);
+	size_t find(Kernel const &kernel, const void *haystack, size_t const &size, const void *needle, size_t const &needleSize);
+	Kernel getBestKernel();
+	bool isSupported(Kernel const &kernel);
+	const char *getKernelName(Kernel const &kernel);
+};
+
+#endif
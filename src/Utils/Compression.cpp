@@ -0,0 +1,90 @@
+#include "Compression.hpp"
+
+namespace
+{
+	// z_stream set up for a gzip wrapper (window bits + 16), freed with the object
+	class GzipStream
+	{
+	private:
+		z_stream stream;
+
+		GzipStream(const GzipStream &) = delete;
+		GzipStream &operator=(const GzipStream &) = delete;
+
+	public:
+		GzipStream()
+		{
+			stream.zalloc = Z_NULL;
+			stream.zfree = Z_NULL;
+			stream.opaque = Z_NULL;
+			if (deflateInit2(&stream, GZIP_COMPRESSION_LEVEL, Z_DEFLATED, MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+				throw std::runtime_error("Failed to initialize gzip");
+		}
+
+		~GzipStream()
+		{
+			deflateEnd(&stream);
+		}
+
+		// the most deflate can make of size bytes, gzip header and trailer included
+		size_t bound(size_t size)
+		{
+			return deflateBound(&stream, size);
+		}
+
+		// compress one chunk of input, Z_FINISH with the last one
+		void deflateChunk(const std::byte *data, size_t size, int flush, std::vector<std::byte> &output)
+		{
+			stream.next_in = reinterpret_cast<Bytef *>(const_cast<std::byte *>(data));
+			stream.avail_in = size;
+			do
+			{
+				size_t used = output.size();
+				output.resize(used + GZIP_CHUNK_SIZE);
+				stream.next_out = reinterpret_cast<Bytef *>(output.data() + used);
+				stream.avail_out = GZIP_CHUNK_SIZE;
+				if (deflate(&stream, flush) == Z_STREAM_ERROR)
+					throw std::runtime_error("Failed to gzip");
+				output.resize(used + GZIP_CHUNK_SIZE - stream.avail_out);
+			} while (stream.avail_out == 0);
+		}
+	};
+}
+
+std::vector<std::byte> Compression::gzip(std::vector<std::byte> const &data)
+{
+	GzipStream stream;
+	std::vector<std::byte> output;
+	output.reserve(stream.bound(data.size()));
+	size_t offset = 0;
+	do
+	{
+		size_t size = std::min(data.size() - offset, static_cast<size_t>(GZIP_CHUNK_SIZE));
+		bool last = (offset + size == data.size());
+		stream.deflateChunk(data.data() + offset, size, last ? Z_FINISH : Z_NO_FLUSH, output);
+		offset += size;
+	} while (offset < data.size());
+	return output;
+}
+
+// read from the open fd chunk by chunk, the file itself is never whole in memory
+std::vector<std::byte> Compression::gzipFile(OpenFile const &file, size_t const &maxFileSize)
+{
+	if (static_cast<size_t>(file.getSize()) > maxFileSize)
+		throw std::runtime_error("File too large to gzip");
+	GzipStream stream;
+	std::vector<std::byte> output;
+	output.reserve(stream.bound(file.getSize()));
+	std::vector<std::byte> chunk(GZIP_CHUNK_SIZE);
+	off_t offset = 0;
+	do
+	{
+		size_t size = std::min(static_cast<size_t>(file.getSize() - offset), chunk.size());
+		ssize_t bytes = (size == 0 ? 0 : pread(file.getFd(), chunk.data(), size, offset));
+		if (bytes < 0 || (bytes == 0 && size != 0)) // error, or the file got shorter since it was opened
+			throw std::runtime_error("Failed to read file to gzip");
+		offset += bytes;
+		stream.deflateChunk(chunk.data(), bytes, offset == file.getSize() ? Z_FINISH : Z_NO_FLUSH, output);
+	} while (offset < file.getSize());
+	return output;
+}
@@ -0,0 +1,25 @@
+#ifndef COMPRESSION_HPP
+#define COMPRESSION_HPP
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <unistd.h>
+#include <zlib.h>
+
+#include "OpenFile.hpp"
+#include "../defines.hpp"
+
+/* gzip with zlib. The input is fed to deflate GZIP_CHUNK_SIZE bytes at a time into an output
+ * reserved at deflateBound() of the input, so apart from the result only one chunk is in memory.
+ * A file is only compressed up to maxFileSize (content_cache_max_file_size), a bigger one throws
+ * and is sent as it is.
+ */
+namespace Compression
+{
+	std::vector<std::byte> gzip(std::vector<std::byte> const &data);
+	std::vector<std::byte> gzipFile(OpenFile const &file, size_t const &maxFileSize);
+};
+
+#endif
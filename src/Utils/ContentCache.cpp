@@ -0,0 +1,130 @@
+#include "ContentCache.hpp"
+
+ContentCache::ContentCache()
+	: budget(0), maxFileSize(0), bytesCached(0) {}
+
+ContentCache &ContentCache::getInstance()
+{
+	static thread_local ContentCache cache;
+	return (cache);
+}
+
+// a budget of 0 turns the cache off
+void ContentCache::configure(size_t const &budget, size_t const &maxFileSize)
+{
+	this->budget = budget;
+	this->maxFileSize = maxFileSize;
+	entries.clear();
+	lru.clear();
+	bytesCached = 0;
+}
+
+// the whole file, read from the already open fd
+ContentCache::Buffer ContentCache::readFile(OpenFile const &file)
+{
+	std::vector<std::byte> data(file.getSize());
+	size_t filled = 0;
+	while (filled < data.size())
+	{
+		ssize_t bytes = pread(file.getFd(), data.data() + filled, data.size() - filled, filled);
+		if (bytes <= 0) // error, or the file got shorter since it was opened
+			return (nullptr);
+		filled += bytes;
+	}
+	return (std::make_shared<const std::vector<std::byte>>(std::move(data)));
+}
+
+void ContentCache::erase(std::unordered_map<std::string, Entry>::iterator const &it)
+{
+	bytesCached -= it->second.buffer->size();
+	lru.erase(it->second.lruPosition);
+	entries.erase(it);
+}
+
+// the cached buffer for key if it was made from the file as it is now
+ContentCache::Buffer ContentCache::find(std::string const &key, OpenFile const &file)
+{
+	std::unordered_map<std::string, Entry>::iterator it = entries.find(key);
+	if (it == entries.end())
+		return (nullptr);
+	Entry &entry = it->second;
+	if (entry.lastModified != file.getLastModified() || entry.size != file.getSize())
+	{
+		erase(it);
+		return (nullptr);
+	}
+	lru.splice(lru.begin(), lru, entry.lruPosition);
+	return (entry.buffer);
+}
+
+void ContentCache::store(std::string const &key, Buffer const &buffer, OpenFile const &file)
+{
+	if (budget == 0 || buffer->size() > budget)
+		return;
+	while (!lru.empty() && bytesCached + buffer->size() > budget)
+		erase(entries.find(lru.back()));
+	lru.push_front(key);
+	entries[key] = {buffer, file.getLastModified(), file.getSize(), lru.begin()};
+	bytesCached += buffer->size();
+}
+
+/* The content of the file opened from path, nullptr when it is not cached (cache off, file too
+ * big, read failed), then the caller sends it from the file.
+ */
+ContentCache::Buffer ContentCache::get(std::string path, OpenFile const &file)
+{
+	size_t fileSize = file.getSize();
+	if (budget == 0 || fileSize > maxFileSize || fileSize > budget)
+		return (nullptr);
+	path = StringUtils::trimChar(path, '/');
+	Buffer buffer = find(path, file);
+	if (buffer)
+		return (buffer);
+	buffer = readFile(file);
+	if (buffer)
+		store(path, buffer, file);
+	return (buffer);
+}
+
+/* The file gzipped, compressed once and then cached like its plain content. nullptr when it could
+ * not be kept (cache off, file too big), that one is sent as it is rather than compressed again for
+ * every request.
+ */
+ContentCache::Buffer ContentCache::getGzipped(std::string path, OpenFile const &file)
+{
+	size_t fileSize = file.getSize();
+	if (budget == 0 || fileSize > maxFileSize || fileSize > budget)
+		return (nullptr);
+	std::string key = StringUtils::trimChar(path, '/') + GZIP_CACHE_KEY_SUFFIX;
+	Buffer buffer = find(key, file);
+	if (buffer)
+		return (buffer);
+	try
+	{
+		buffer = std::make_shared<const std::vector<std::byte>>(Compression::gzipFile(file, maxFileSize));
+	}
+	catch (std::runtime_error &e)
+	{
+		return (nullptr);
+	}
+	store(key, buffer, file);
+	return (buffer);
+}
+
+// the server changed the file itself (upload, delete)
+void ContentCache::invalidate(std::string path)
+{
+	path = StringUtils::trimChar(path, '/');
+	std::string const keys[] = {path, path + GZIP_CACHE_KEY_SUFFIX};
+	for (std::string const &key : keys)
+	{
+		std::unordered_map<std::string, Entry>::iterator it = entries.find(key);
+		if (it != entries.end())
+			erase(it);
+	}
+}
+
+size_t ContentCache::size() const
+{
+	return (bytesCached);
+}
@@ -0,0 +1,64 @@
+#ifndef CONTENTCACHE_HPP
+#define CONTENTCACHE_HPP
+
+#include <string>
+#include <list>
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <unordered_map>
+#include <unistd.h>
+
+#include "OpenFile.hpp"
+#include "Compression.hpp"
+#include "StringUtils.hpp"
+
+#define GZIP_CACHE_KEY_SUFFIX "\ngzip" // a newline is never part of a path
+
+/* The content of small, often served files, kept in memory within a byte budget.
+ * A cached buffer is immutable and shared: every response for the file and the output queues
+ * sending it hold the same buffer, which lives on until the last of them lets it go even if
+ * the cache already dropped it. An entry is only used while the file still has the size and
+ * mtime it was read with. One cache per worker thread, the least recently used entries go
+ * when the budget is full. The gzipped content of a file is cached next to it, under its own key.
+ */
+class ContentCache
+{
+public:
+	typedef std::shared_ptr<const std::vector<std::byte>> Buffer;
+
+private:
+	struct Entry
+	{
+		Buffer buffer;
+		time_t lastModified;
+		off_t size;
+		std::list<std::string>::iterator lruPosition;
+	};
+
+	size_t budget;
+	size_t maxFileSize;
+	size_t bytesCached;
+	std::unordered_map<std::string, Entry> entries;
+	std::list<std::string> lru; // most recently used first
+
+	ContentCache();
+	ContentCache(const ContentCache &) = delete;
+	ContentCache &operator=(const ContentCache &) = delete;
+
+	static Buffer readFile(OpenFile const &file);
+	Buffer find(std::string const &key, OpenFile const &file);
+	void store(std::string const &key, Buffer const &buffer, OpenFile const &file);
+	void erase(std::unordered_map<std::string, Entry>::iterator const &it);
+
+public:
+	static ContentCache &getInstance(); // the cache of the calling thread
+
+	void configure(size_t const &budget, size_t const &maxFileSize);
+	Buffer get(std::string path, OpenFile const &file);
+	Buffer getGzipped(std::string path, OpenFile const &file);
+	void invalidate(std::string path);
+	size_t size() const;
+};
+
+#endif
@@ -52,7 +52,7 @@ void FileSystemUtils::createDirectory(const std::string &path)
 	}
 }
 
-void FileSystemUtils::saveFile(std::string savePath, std::string fileName, std::vector<std::byte> body)
+void FileSystemUtils::saveFile(std::string savePath, std::string fileName, const std::byte *data, size_t const &size)
 {
 	createDirectory(savePath);
 	std::string fullPath = StringUtils::joinPath(savePath, fileName);
@@ -61,10 +61,102 @@ void FileSystemUtils::saveFile(std::string savePath, std::string fileName, std::
 	{
 		throw std::runtime_error("Failed to open file: " + fullPath);
 	}
-	fileStream.write(reinterpret_cast<const char *>(body.data()), body.size());
+	fileStream.write(reinterpret_cast<const char *>(data), size);
 	fileStream.close();
 }
 
+#ifdef __linux__
+// the kernel copies from offset on, false when it cannot between these two files and the rest is left to the caller
+static bool copyInKernel(int const &fd, int const &fileFd, size_t const &size, off_t &offset)
+{
+	bool useSendfile = false;
+	while (static_cast<size_t>(offset) < size)
+	{
+		loff_t rangeOffset = offset;
+		ssize_t copied = useSendfile ? sendfile(fileFd, fd, &offset, size - offset)
+									 : copy_file_range(fd, &rangeOffset, fileFd, nullptr, size - offset, 0);
+		if (copied < 0 && (errno == EXDEV || errno == ENOSYS || errno == EINVAL || errno == EOPNOTSUPP))
+		{
+			if (useSendfile)
+				return (false);
+			useSendfile = true; // across file systems on older kernels
+			continue;
+		}
+		if (copied < 0 && errno == EINTR)
+			continue;
+		if (copied <= 0)
+			return (false);
+		if (!useSendfile)
+			offset = rangeOffset;
+	}
+	return (true);
+}
+#endif
+
+// the same copy through a buffer, what the kernel could not copy
+static bool copyThroughBuffer(int const &fd, int const &fileFd, size_t const &size, off_t offset)
+{
+	std::vector<char> buffer(FILE_COPY_BUFFER_SIZE);
+	while (static_cast<size_t>(offset) < size)
+	{
+		ssize_t bytes = pread(fd, buffer.data(), std::min(buffer.size(), size - offset), offset);
+		if (bytes < 0 && errno == EINTR)
+			continue;
+		if (bytes <= 0)
+			return (false);
+		ssize_t written = 0;
+		while (written < bytes)
+		{
+			ssize_t result = pwrite(fileFd, buffer.data() + written, bytes - written, offset + written);
+			if (result < 0 && errno == EINTR)
+				continue;
+			if (result <= 0)
+				return (false);
+			written += result;
+		}
+		offset += bytes;
+	}
+	return (true);
+}
+
+/* The content of an unlinked temporary file. On Linux an O_TMPFILE file on the same file system
+ * is linked into place and nothing is copied, otherwise the kernel copies it without it passing
+ * through here. Where neither works, or elsewhere, it is read and written through a buffer.
+ */
+void FileSystemUtils::saveFile(std::string savePath, std::string fileName, int const &fd, size_t const &size)
+{
+	createDirectory(savePath);
+	std::string fullPath = StringUtils::joinPath(savePath, fileName);
+	fchmod(fd, 0644);
+	unlink(fullPath.c_str()); // replaced like an existing file is by the other saveFile()
+#ifdef __linux__
+	std::string fdPath = "/proc/self/fd/" + std::to_string(fd);
+	if (linkat(AT_FDCWD, fdPath.c_str(), AT_FDCWD, fullPath.c_str(), AT_SYMLINK_FOLLOW) == 0)
+	{
+		return; // otherwise a named spool file, no /proc, another file system or no permission to link: it is copied
+	}
+#endif
+	int fileFd = open(fullPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (fileFd < 0)
+	{
+		throw std::runtime_error("Failed to open file: " + fullPath);
+	}
+	off_t offset = 0;
+	bool copied = false;
+#ifdef __linux__
+	copied = copyInKernel(fd, fileFd, size, offset);
+#endif
+	if (!copied)
+	{
+		copied = copyThroughBuffer(fd, fileFd, size, offset);
+	}
+	close(fileFd);
+	if (!copied)
+	{
+		throw std::runtime_error("Failed to write file: " + fullPath);
+	}
+}
+
 void FileSystemUtils::deleteFile(const std::string &path)
 {
 	if (remove(path.c_str()) != 0)
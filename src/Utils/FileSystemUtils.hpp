@@ -3,7 +3,12 @@
 
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <fcntl.h>
 #include <unistd.h>
+#include <cerrno>
+#ifdef __linux__
+#include <sys/sendfile.h>
+#endif
 #include <string>
 #include <fstream>
 #include <vector>
@@ -18,7 +23,8 @@ namespace FileSystemUtils
 	bool isDir(const std::string &target);
 	bool isFile(const std::string &target);
 	void createDirectory(const std::string &path);
-	void saveFile(std::string savePath, std::string fileName, std::vector<std::byte> body);
+	void saveFile(std::string savePath, std::string fileName, const std::byte *data, size_t const &size);
+	void saveFile(std::string savePath, std::string fileName, int const &fd, size_t const &size);
 	void deleteFile(const std::string &path);
 }
 
@@ -120,6 +120,35 @@ namespace HttpUtils
 		{ContentType::MULTIPART_FORM_DATA, "multipart/form-data"},
 		{ContentType::APPLICATION_X_WWW_FORM_URLENCODED, "application/x-www-form-urlencoded"}};
 
+	// by file extension, for the static files
+	const std::unordered_map<std::string, ContentType> _extensionContentTypes = {
+		{"txt", ContentType::TEXT_PLAIN},
+		{"html", ContentType::TEXT_HTML},
+		{"htm", ContentType::TEXT_HTML},
+		{"css", ContentType::TEXT_CSS},
+		{"js", ContentType::TEXT_JAVASCRIPT},
+		{"mjs", ContentType::TEXT_JAVASCRIPT},
+		{"json", ContentType::APPLICATION_JSON},
+		{"xml", ContentType::APPLICATION_XML},
+		{"pdf", ContentType::APPLICATION_PDF},
+		{"zip", ContentType::APPLICATION_ZIP},
+		{"jpg", ContentType::IMAGE_JPEG},
+		{"jpeg", ContentType::IMAGE_JPEG},
+		{"png", ContentType::IMAGE_PNG},
+		{"gif", ContentType::IMAGE_GIF},
+		{"svg", ContentType::IMAGE_SVG},
+		{"webp", ContentType::IMAGE_WEBP},
+		{"ico", ContentType::IMAGE_ICO},
+		{"bmp", ContentType::IMAGE_BMP},
+		{"tiff", ContentType::IMAGE_TIFF},
+		{"mp3", ContentType::AUDIO_MPEG},
+		{"wav", ContentType::AUDIO_WAV},
+		{"mp4", ContentType::VIDEO_MP4},
+		{"webm", ContentType::VIDEO_WEBM},
+		{"mpeg", ContentType::VIDEO_MPEG},
+		{"mov", ContentType::VIDEO_QUICKTIME},
+		{"avi", ContentType::VIDEO_AVI}};
+
 	const std::unordered_map<std::string, HttpMethod> _strToHttpMethod = {
 		{"GET", HttpMethod::GET},
 		{"HEAD", HttpMethod::HEAD},
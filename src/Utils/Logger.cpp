@@ -26,9 +26,11 @@ const std::string Logger::_createTimeStamp()
 	std::stringstream tmp;
 	char buffer[100];
 	time_t now = time(nullptr);
+	struct tm localTime;
 
 	tmp << "[";
-	strftime(buffer, 100, "%Y-%m-%d %X", localtime(&now));
+	localtime_r(&now, &localTime); // workers log from several threads
+	strftime(buffer, 100, "%Y-%m-%d %X", &localTime);
 	tmp << buffer << "]";
 	return tmp.str();
 }
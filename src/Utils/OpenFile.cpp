@@ -0,0 +1,53 @@
+#include "OpenFile.hpp"
+
+// same path handling as BinaryData::getFileData
+OpenFile::OpenFile(std::string path) : fd(-1), size(0), lastModified(0)
+{
+	path = StringUtils::trimChar(path, '/');
+	if ((fd = open(path.c_str(), O_RDONLY | O_CLOEXEC)) < 0)
+		throw std::runtime_error("Failed to open file: " + path);
+	struct stat fileStat;
+	if (fstat(fd, &fileStat) < 0 || !S_ISREG(fileStat.st_mode))
+	{
+		close(fd);
+		throw std::runtime_error("Not a regular file: " + path);
+	}
+	size = fileStat.st_size;
+	lastModified = fileStat.st_mtime;
+}
+
+// a file that is already open elsewhere, e.g. a spooled request body, through a descriptor of its own
+OpenFile::OpenFile(int const &openFd) : fd(-1), size(0), lastModified(0)
+{
+	if ((fd = fcntl(openFd, F_DUPFD_CLOEXEC, 0)) < 0)
+		throw std::runtime_error("Failed to duplicate file descriptor");
+	struct stat fileStat;
+	if (fstat(fd, &fileStat) < 0 || !S_ISREG(fileStat.st_mode))
+	{
+		close(fd);
+		throw std::runtime_error("Not a regular file descriptor");
+	}
+	size = fileStat.st_size;
+	lastModified = fileStat.st_mtime;
+}
+
+OpenFile::~OpenFile()
+{
+	if (fd >= 0)
+		close(fd);
+}
+
+int const &OpenFile::getFd() const
+{
+	return (fd);
+}
+
+off_t const &OpenFile::getSize() const
+{
+	return (size);
+}
+
+time_t const &OpenFile::getLastModified() const
+{
+	return (lastModified);
+}
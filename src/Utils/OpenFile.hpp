@@ -0,0 +1,34 @@
+#ifndef OPENFILE_HPP
+#define OPENFILE_HPP
+
+#include <string>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include "StringUtils.hpp"
+
+// a regular file opened for reading, closed when the last owner lets it go
+class OpenFile
+{
+private:
+	int fd;
+	off_t size;
+	time_t lastModified;
+
+	OpenFile(const OpenFile &) = delete;
+	OpenFile &operator=(const OpenFile &) = delete;
+
+public:
+	OpenFile(std::string path);
+	OpenFile(int const &openFd);
+	~OpenFile();
+
+	int const &getFd() const;
+	off_t const &getSize() const;
+	time_t const &getLastModified() const;
+};
+
+#endif
@@ -0,0 +1,135 @@
+#include "OpenFileCache.hpp"
+
+OpenFileCache::OpenFileCache()
+	: maxEntries(0), validMs(0), cacheErrors(false) {}
+
+OpenFileCache &OpenFileCache::getInstance()
+{
+	static thread_local OpenFileCache cache;
+	return (cache);
+}
+
+// 0 entries turns the cache off, every lookup then goes to the file system
+void OpenFileCache::configure(size_t const &maxEntries, size_t const &validMs, bool const &cacheErrors)
+{
+	this->maxEntries = maxEntries;
+	this->validMs = validMs;
+	this->cacheErrors = cacheErrors;
+	entries.clear();
+	lru.clear();
+}
+
+// one stat() for everything the response asks about the path, the file is opened later if it is sent
+OpenFileCache::FileInfo OpenFileCache::load(std::string const &path, struct stat &pathStat)
+{
+	FileInfo info;
+	if (stat(path.c_str(), &pathStat) < 0)
+	{
+		info.error = errno;
+		return (info);
+	}
+	info.error = 0;
+	info.isDir = S_ISDIR(pathStat.st_mode);
+	info.isFile = S_ISREG(pathStat.st_mode);
+	info.inode = pathStat.st_ino;
+	info.size = pathStat.st_size;
+	info.lastModified = pathStat.st_mtime;
+	return (info);
+}
+
+bool OpenFileCache::isSameFile(Entry const &entry, struct stat const &pathStat)
+{
+	return (entry.device == pathStat.st_dev && entry.inode == pathStat.st_ino && entry.lastModified == pathStat.st_mtime &&
+			entry.size == pathStat.st_size && entry.info.isDir == S_ISDIR(pathStat.st_mode));
+}
+
+void OpenFileCache::insert(std::string const &path, FileInfo const &info, struct stat const &pathStat)
+{
+	while (!lru.empty() && entries.size() >= maxEntries)
+		erase(entries.find(lru.back()));
+	lru.push_front(path);
+	Entry entry = {info, 0, 0, 0, 0, std::chrono::steady_clock::now() + std::chrono::milliseconds(validMs), lru.begin()};
+	if (info.error == 0)
+	{
+		entry.device = pathStat.st_dev;
+		entry.inode = pathStat.st_ino;
+		entry.lastModified = pathStat.st_mtime;
+		entry.size = pathStat.st_size;
+	}
+	entries[path] = entry;
+}
+
+void OpenFileCache::erase(std::unordered_map<std::string, Entry>::iterator const &it)
+{
+	lru.erase(it->second.lruPosition);
+	entries.erase(it);
+}
+
+/* Paths are taken the way OpenFile takes them, without leading and trailing '/'.
+ * A valid entry is answered without any syscall. An expired one costs a stat() and keeps its open
+ * file if the path still points to the same unchanged file, or the same error.
+ */
+OpenFileCache::FileInfo OpenFileCache::lookup(std::string path)
+{
+	path = StringUtils::trimChar(path, '/');
+	if (path.empty())
+		path = ".";
+	struct stat pathStat;
+	if (maxEntries == 0)
+		return (load(path, pathStat));
+
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	std::unordered_map<std::string, Entry>::iterator it = entries.find(path);
+	if (it != entries.end())
+	{
+		Entry &entry = it->second;
+		lru.splice(lru.begin(), lru, entry.lruPosition);
+		if (now < entry.validUntil)
+			return (entry.info);
+		bool unchanged;
+		if (stat(path.c_str(), &pathStat) < 0)
+			unchanged = (entry.info.error == errno);
+		else
+			unchanged = (entry.info.error == 0 && isSameFile(entry, pathStat));
+		if (unchanged)
+		{
+			entry.validUntil = now + std::chrono::milliseconds(validMs);
+			return (entry.info);
+		}
+		erase(it);
+	}
+	FileInfo info = load(path, pathStat);
+	if (info.error == 0 || cacheErrors)
+		insert(path, info, pathStat);
+	return (info);
+}
+
+/* The open file of a lookup, opened now if the entry has none yet, throws if it cannot be.
+ * The file is kept in the entry when it is still the one the entry was stat()ed from.
+ */
+std::shared_ptr<OpenFile> OpenFileCache::open(FileInfo const &info, std::string const &path)
+{
+	if (info.file)
+		return (info.file);
+	std::shared_ptr<OpenFile> file = std::make_shared<OpenFile>(path);
+	std::unordered_map<std::string, Entry>::iterator it = entries.find(StringUtils::trimChar(path, '/'));
+	struct stat fileStat;
+	if (it != entries.end() && it->second.info.isFile && !it->second.info.file && it->second.inode == info.inode &&
+		fstat(file->getFd(), &fileStat) == 0 && isSameFile(it->second, fileStat))
+		it->second.info.file = file;
+	return (file);
+}
+
+// the server changed the file itself (upload, delete), do not wait for the entry to expire
+void OpenFileCache::invalidate(std::string path)
+{
+	path = StringUtils::trimChar(path, '/');
+	std::unordered_map<std::string, Entry>::iterator it = entries.find(path);
+	if (it != entries.end())
+		erase(it);
+}
+
+size_t OpenFileCache::size() const
+{
+	return (entries.size());
+}
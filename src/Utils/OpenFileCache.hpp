@@ -0,0 +1,74 @@
+#ifndef OPENFILECACHE_HPP
+#define OPENFILECACHE_HPP
+
+#include <string>
+#include <list>
+#include <memory>
+#include <chrono>
+#include <unordered_map>
+#include <cerrno>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include "OpenFile.hpp"
+#include "StringUtils.hpp"
+
+/* Like nginx's open_file_cache: what stat() said about a path, plus the open file when it is a
+ * regular one, so that serving a hot file costs no path lookup at all until the entry is no longer
+ * valid. A lookup never opens the file, so a 304 decided from its stat() data opens nothing; the file
+ * is opened when it is sent and kept in the entry from then on. With the cache off a lookup is a
+ * single stat(). An expired entry is checked with one stat() and kept (with its fd) if the file is
+ * still the same. One cache per worker thread, the least recently used entry goes when it is full.
+ */
+class OpenFileCache
+{
+public:
+	struct FileInfo
+	{
+		int error = ENOENT; // errno of the failed stat(), 0 if the path exists
+		bool isDir = false;
+		bool isFile = false;
+		ino_t inode = 0;
+		off_t size = 0;
+		time_t lastModified = 0;
+		std::shared_ptr<OpenFile> file; // set once a cached regular file has been opened
+	};
+
+private:
+	struct Entry
+	{
+		FileInfo info;
+		dev_t device;
+		ino_t inode;
+		time_t lastModified;
+		off_t size;
+		std::chrono::steady_clock::time_point validUntil;
+		std::list<std::string>::iterator lruPosition;
+	};
+
+	size_t maxEntries;
+	size_t validMs;
+	bool cacheErrors;
+	std::unordered_map<std::string, Entry> entries;
+	std::list<std::string> lru; // most recently used first
+
+	OpenFileCache();
+	OpenFileCache(const OpenFileCache &) = delete;
+	OpenFileCache &operator=(const OpenFileCache &) = delete;
+
+	static FileInfo load(std::string const &path, struct stat &pathStat);
+	static bool isSameFile(Entry const &entry, struct stat const &pathStat);
+	void insert(std::string const &path, FileInfo const &info, struct stat const &pathStat);
+	void erase(std::unordered_map<std::string, Entry>::iterator const &it);
+
+public:
+	static OpenFileCache &getInstance(); // the cache of the calling thread
+
+	void configure(size_t const &maxEntries, size_t const &validMs, bool const &cacheErrors);
+	FileInfo lookup(std::string path);
+	std::shared_ptr<OpenFile> open(FileInfo const &info, std::string const &path);
+	void invalidate(std::string path);
+	size_t size() const;
+};
+
+#endif
@@ -54,6 +54,13 @@ bool StringUtils::isDigitsOnly(const std::string &str)
 		{ return std::isdigit(c); });
 }
 
+bool StringUtils::equalsIgnoreCase(std::string_view a, std::string_view b)
+{
+	return a.size() == b.size() &&
+		   std::equal(a.begin(), a.end(), b.begin(), [](unsigned char x, unsigned char y)
+					  { return std::tolower(x) == std::tolower(y); });
+}
+
 size_t StringUtils::strToSizeT(const std::string &str)
 {
 	if (str.empty() || !isDigitsOnly(str))
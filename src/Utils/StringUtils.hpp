@@ -2,6 +2,7 @@
 #define STRING_UTILS_HPP
 
 #include <string>
+#include <string_view>
 #include <limits>
 #include <stdexcept>
 #include <cstdlib>
@@ -18,6 +19,7 @@ namespace StringUtils
 	std::vector<std::string> splitByDelimiter(const std::string &input, const std::string &delimiter);
 	std::string trim(const std::string &str);
 	bool isDigitsOnly(const std::string &str);
+	bool equalsIgnoreCase(std::string_view a, std::string_view b);
 	void replaceAll(std::string &str, const std::string &from, const std::string &to);
 	std::unordered_map<std::string, std::string> parseQueryString(const std::string &queryString);
 	std::string trimChar(const std::string &str, char ch);
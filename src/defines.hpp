@@ -3,6 +3,7 @@
 
 #define SERVER_SOFTWARE "webservant v0.1"
 #define DEFAULT_ERROR_MESSAGE "An error occurred"
+#define CONTINUE_RESPONSE "HTTP/1.1 100 Continue\r\n\r\n"
 #define CRITICAL_ERROR_RESPONSE "HTTP/1.1 500 Internal Server Error\r\nContent-Length: 0\r\nConnection: close\r\n\r\n"
 // TODO: change path to match from directory of the binary
 #define DEFAULT_ERROR_TEMPLATE_PATH "./pages/errorPage.html"
@@ -28,12 +29,10 @@
 #define DIGIT_REGEX "[0-9]"
 #define ALPHA_REGEX "[A-Za-z]"
 #define RWS_REGEX "[\t ]+"
-#define URL_REGEX "[a-zA-Z0-9-._~:/?#@!$&'()*+,;=%]+"
+#define TOKEN_SPECIAL_CHARS "!#$%&'*+-.^_`|~"		  // tchar of RFC 9110 besides DIGIT and ALPHA
+#define TARGET_SPECIAL_CHARS "-._~:/?#@!$&'()*+,;=%" // allowed in a request target besides DIGIT and ALPHA
 
 #define IMPLEMENTED_HTTP_METHODS_REGEX "(GET|HEAD|POST|DELETE)"
-#define REQUEST_LINE_REGEX "^" \
-						   "(" ALPHA_REGEX "+)" SP "(.+)" SP "HTTP/(\\d{1,3})\\.(\\d{1,3})?$"
-#define HOST_REGEX "([^:]+):(\\d+)"
 
 #define GATEWAY_INTERFACE "CGI/1.1"
 #define SERVER_PROTOCOL "HTTP/1.1"
@@ -44,10 +43,35 @@
 #define CGI_EXIT_SUCCESS 0
 
 #define BACKLOG 512
-#define SERVER_BUFFER_SIZE 100000
-#define MAX_REQUEST_HEADER_LENGTH 8192
+#define INPUT_BUFFER_BLOCK_SIZE 65536 // per-connection input buffer, grows only for a request head that does not fit
+#define INPUT_BUFFER_MIN_READ 4096	   // free space a recv() is given at least
+#define INPUT_BUFFER_POOL_SIZE 64	   // free blocks a worker keeps for its next connections
+#define DEFAULT_CLIENT_MAX_HEADER_SIZE 8192
+#define DEFAULT_CLIENT_BODY_BUFFER_SIZE 1048576
+#define CLIENT_BODY_TEMP_DIR "/tmp" // where request bodies over client_body_buffer_size are spooled
+#define FILE_COPY_BUFFER_SIZE 65536 // a spooled upload copied into place where the kernel cannot copy it
+#define MAX_HEADER_FIELDS 100
+#define CHUNKED_MAX_LINE_LENGTH 4096 // a chunk size line with its extensions, or a trailer field
+#define RANGE_MAX_DIGITS 18 // of a byte position in a Range header, so it fits in a long long
+#define MULTIPART_MAX_HEADER_SIZE 8192 // the headers of one part of a multipart/form-data body
+#define MULTIPART_MAX_PARTS 128 // of one multipart/form-data body, a spooled part holds a file descriptor
 
 #define SERVER_TIMEOUT 60000
+#define TIMER_WHEEL_TICK_MS 100
+#define TIMER_WHEEL_LEVELS 3
+#define TIMER_WHEEL_ROOT_BITS 8  // 256 ticks in the root level
+#define TIMER_WHEEL_LEVEL_BITS 6 // 64 slots in every upper level
+#define EPOLL_MAX_EVENTS 1024
+#define SHED_RETRY_AFTER_SECONDS 1 // Retry-After of the 503 sent to connections over max_connections
+#define ACCEPT_PAUSE_MS 500		   // how long accepting stops when the process is out of fds
+#define OUTPUT_QUEUE_MAX_IOV 64			// segments handed to one writev()
+#define OUTPUT_QUEUE_SEND_BUDGET 1048576 // bytes sent to one client per writable event
+#define DEFAULT_STREAM_WINDOW_SIZE 65536
+#define GZIP_COMPRESSION_LEVEL 6
+#define GZIP_CHUNK_SIZE 16384 // input and output steps of deflate
+#define DEFAULT_GZIP_MIN_LENGTH 20
+#define MAX_BYTE_RANGES 16 // more ranges in one request are ignored, the whole body is sent
+#define MAX_CONNECTION_TABLE_SIZE 65536 // upper bound of the fd-indexed connection table of a worker
 
 enum ConnectionValue
 {
@@ -56,6 +80,21 @@ enum ConnectionValue
 	UPGRADE
 };
 
+// which deadline a client connection is currently waiting on
+enum ClientTimeout
+{
+	CLIENT_HEADER_TIMEOUT,
+	CLIENT_BODY_TIMEOUT,
+	KEEPALIVE_TIMEOUT,
+	SEND_TIMEOUT
+};
+
+enum EventEngine
+{
+	ENGINE_POLL,
+	ENGINE_EPOLL
+};
+
 enum HttpMethod
 {
 	UNDEFINED_METHOD,
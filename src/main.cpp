@@ -19,7 +19,7 @@ int main(int argc, char **argv)
 		ConfigParser parser(fileName);
 		parser.extractServerConfigs();
 		// parser.printCluster(); // debug
-		server_manager.initServer(parser.getServerConfigs());
+		server_manager.initServer(parser.getServerConfigs(), parser.getGlobalConfig());
 	}
 	catch (std::exception &e)
 	{
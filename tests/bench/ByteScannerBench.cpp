@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../../src/Utils/ByteScanner.hpp"
+
+// delimiter search on a ~1 KB request head and on a 100 MB multipart body, every kernel against the std searches
+
+namespace
+{
+	volatile size_t sink;
+
+	double measureNs(std::function<size_t()> const &search, size_t const &iterations)
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < iterations; ++i)
+			sink = search();
+		std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+		return (elapsed.count() / iterations);
+	}
+
+	void run(std::string const &name, std::string const &haystack, std::string const &needle, size_t const &iterations)
+	{
+		size_t expected = haystack.find(needle);
+		std::printf("%s: %zu bytes, needle of %zu bytes at %zu\n", name.c_str(), haystack.size(), needle.size(), expected);
+
+		std::vector<std::pair<std::string, std::function<size_t()>>> searches;
+		searches.push_back({"std::string::find", [&]()
+							{ return haystack.find(needle); }});
+		searches.push_back({"std::search", [&]()
+							{ return static_cast<size_t>(std::search(haystack.begin(), haystack.end(), needle.begin(), needle.end()) - haystack.begin()); }});
+		for (ByteScanner::Kernel kernel : {ByteScanner::SCALAR, ByteScanner::SSE2, ByteScanner::AVX2})
+		{
+			if (!ByteScanner::isSupported(kernel))
+				continue;
+			searches.push_back({std::string("ByteScanner ") + ByteScanner::getKernelName(kernel), [&, kernel]()
+								{ return ByteScanner::find(kernel, haystack.data(), haystack.size(), needle.data(), needle.size()); }});
+		}
+
+		double baseline = 0;
+		for (std::pair<std::string, std::function<size_t()>> const &search : searches)
+		{
+			if (search.second() != expected)
+			{
+				std::printf("  %-22s WRONG RESULT\n", search.first.c_str());
+				continue;
+			}
+			double ns = measureNs(search.second, iterations);
+			if (baseline == 0)
+				baseline = ns;
+			std::printf("  %-22s %12.1f ns %9.2f GB/s %7.2fx\n", search.first.c_str(), ns, haystack.size() / ns, baseline / ns);
+		}
+	}
+
+	std::string makeRequestHead()
+	{
+		std::string head = "POST /upload/ HTTP/1.1\r\n"
+						   "Host: localhost:10001\r\n"
+						   "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/124.0 Safari/537.36\r\n"
+						   "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,image/avif,image/webp,*/*;q=0.8\r\n"
+						   "Accept-Language: en-US,en;q=0.9\r\n"
+						   "Accept-Encoding: gzip, deflate, br\r\n"
+						   "Content-Type: multipart/form-data; boundary=----WebKitFormBoundary7MA4YWxkTrZu0gW\r\n"
+						   "Content-Length: 104857600\r\n"
+						   "Connection: keep-alive\r\n";
+		head += "Cookie: session=";
+		while (head.size() < 1020)
+			head += "a1b2c3d4";
+		head += "\r\n\r\n";
+		return (head);
+	}
+
+	// one file part of random bytes (binary) or of text lines ending in CRLF, the closing delimiter at the very end
+	std::string makeMultipartBody(std::string const &boundary, size_t const &size, bool const &binary)
+	{
+		std::mt19937 random(42);
+		std::uniform_int_distribution<int> printable(' ', '~');
+		std::string body = "--" + boundary + "\r\nContent-Disposition: form-data; name=\"file\"; filename=\"a\"\r\n\r\n";
+		body.reserve(size + 128);
+		while (body.size() < size)
+		{
+			if (binary)
+				body.push_back(static_cast<char>(random()));
+			else if (random() % 64 == 0)
+				body += "\r\n";
+			else
+				body.push_back(static_cast<char>(printable(random)));
+		}
+		body += "\r\n--" + boundary + "--\r\n";
+		return (body);
+	}
+}
+
+int main()
+{
+	std::printf("best kernel: %s\n\n", ByteScanner::getKernelName(ByteScanner::getBestKernel()));
+	run("request head", makeRequestHead(), "\r\n\r\n", 1000000);
+	std::printf("\n");
+	std::string boundary = "----WebKitFormBoundary7MA4YWxkTrZu0gW";
+	run("multipart body, binary file", makeMultipartBody(boundary, 100 * 1024 * 1024, true), "\r\n--" + boundary + "--", 5);
+	std::printf("\n");
+	run("multipart body, text file", makeMultipartBody(boundary, 100 * 1024 * 1024, false), "\r\n--" + boundary + "--", 5);
+	return (0);
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include "ConfigParserTest.hpp"
+#include "../../src/Server/AdmissionControl.hpp"
+
+// Parses a config from its text, the limits are taken from the parsed blocks
+class AdmissionControlTest : public ::testing::Test
+{
+protected:
+    std::unique_ptr<ConfigParser> parser;
+
+    void parse(std::string const &content)
+    {
+        TestConfigFile testFile("configs/test_files/test_AdmissionControl.conf", content);
+        std::string path = testFile.path();
+        parser = std::make_unique<ConfigParser>(path);
+        parser->extractServerConfigs();
+    }
+
+    ConfigData const &server(size_t index) const
+    {
+        return parser->getServerConfigs()[index];
+    }
+};
+
+TEST(ConnectionLimiterTest, StopsAtTheLimit)
+{
+    ConnectionLimiter limiter(2);
+    EXPECT_TRUE(limiter.tryAcquire());
+    EXPECT_TRUE(limiter.tryAcquire());
+    EXPECT_FALSE(limiter.tryAcquire());
+    EXPECT_EQ(limiter.getActive(), 2U);
+    limiter.release();
+    EXPECT_TRUE(limiter.tryAcquire());
+}
+
+TEST(ConnectionLimiterTest, ZeroMeansNoLimit)
+{
+    ConnectionLimiter limiter(0);
+    for (int i = 0; i < 1000; ++i)
+        EXPECT_TRUE(limiter.tryAcquire());
+    EXPECT_EQ(limiter.getActive(), 1000U);
+}
+
+TEST_F(AdmissionControlTest, AppliesTheGlobalLimit)
+{
+    parse("max_connections 2;\n"
+          "server {\n"
+          "    listen 10001;\n"
+          "}\n"
+          "server {\n"
+          "    listen 10002;\n"
+          "}\n");
+    AdmissionControl admission(parser->getGlobalConfig(), parser->getServerConfigs());
+    ConnectionLimiter &first = admission.getListenerLimiter(server(0).getServerHost(), 10001);
+    ConnectionLimiter &second = admission.getListenerLimiter(server(1).getServerHost(), 10002);
+
+    EXPECT_TRUE(admission.admit(first));
+    EXPECT_TRUE(admission.admit(second));
+    EXPECT_FALSE(admission.admit(first));
+    EXPECT_EQ(admission.getActiveConnections(), 2U);
+    admission.release(second);
+    EXPECT_TRUE(admission.admit(first));
+}
+
+TEST_F(AdmissionControlTest, SharesTheListenerLimitBetweenNameBasedServers)
+{
+    parse("server {\n"
+          "    listen 10001;\n"
+          "    server_name a.com;\n"
+          "}\n"
+          "server {\n"
+          "    listen 10001;\n"
+          "    server_name b.com;\n"
+          "    max_connections 1;\n"
+          "}\n");
+    AdmissionControl admission(parser->getGlobalConfig(), parser->getServerConfigs());
+    ConnectionLimiter &limiter = admission.getListenerLimiter(server(0).getServerHost(), 10001);
+
+    EXPECT_EQ(&limiter, &admission.getListenerLimiter(server(1).getServerHost(), 10001));
+    EXPECT_TRUE(admission.admit(limiter));
+    EXPECT_FALSE(admission.admit(limiter)); // the limit set by the second block applies to the first too
+}
+
+TEST_F(AdmissionControlTest, GivesBackTheGlobalSlotWhenTheListenerIsFull)
+{
+    parse("max_connections 10;\n"
+          "server {\n"
+          "    listen 10001;\n"
+          "    max_connections 1;\n"
+          "}\n");
+    AdmissionControl admission(parser->getGlobalConfig(), parser->getServerConfigs());
+    ConnectionLimiter &limiter = admission.getListenerLimiter(server(0).getServerHost(), 10001);
+
+    EXPECT_TRUE(admission.admit(limiter));
+    EXPECT_FALSE(admission.admit(limiter));
+    EXPECT_EQ(admission.getActiveConnections(), 1U);
+}
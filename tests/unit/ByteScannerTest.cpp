@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include "../../src/Utils/ByteScanner.hpp"
+
+static const ByteScanner::Kernel kernels[] = {ByteScanner::SCALAR, ByteScanner::SSE2, ByteScanner::AVX2};
+
+// every kernel this CPU can run has to agree with std::string::find
+static void expectSameAsStringFind(std::string const &haystack, std::string const &needle)
+{
+    size_t expected = haystack.find(needle);
+    for (ByteScanner::Kernel kernel : kernels)
+    {
+        if (!ByteScanner::isSupported(kernel))
+            continue;
+        EXPECT_EQ(ByteScanner::find(kernel, haystack.data(), haystack.size(), needle.data(), needle.size()), expected)
+            << ByteScanner::getKernelName(kernel) << " haystack size " << haystack.size() << " needle \"" << needle << "\"";
+    }
+}
+
+TEST(ByteScannerTest, AlwaysSupportsScalarAndPicksASupportedKernel)
+{
+    EXPECT_TRUE(ByteScanner::isSupported(ByteScanner::SCALAR));
+    EXPECT_TRUE(ByteScanner::isSupported(ByteScanner::getBestKernel()));
+}
+
+TEST(ByteScannerTest, FindsTheDelimitersItIsUsedFor)
+{
+    std::string head = "GET / HTTP/1.1\r\nHost: localhost\r\n\r\nbody";
+    expectSameAsStringFind(head, "\r\n\r\n");
+    expectSameAsStringFind(head, "\r\n");
+    expectSameAsStringFind(std::string(1000, 'x') + "\r\n--boundary", "\r\n--boundary");
+    EXPECT_EQ(ByteScanner::find(head.data(), head.size(), "\r\n\r\n", 4), head.find("\r\n\r\n"));
+}
+
+TEST(ByteScannerTest, HandlesEdgeSizes)
+{
+    expectSameAsStringFind("", "a");
+    expectSameAsStringFind("a", "a");
+    expectSameAsStringFind("ab", "abc"); // needle longer than the haystack
+    expectSameAsStringFind("abc", "");
+    expectSameAsStringFind("", "");
+    std::string needle(40, 'n'); // longer than one AVX2 block
+    expectSameAsStringFind(std::string(100, 'n'), needle);
+    expectSameAsStringFind(std::string(39, 'n') + "m" + needle, needle);
+}
+
+TEST(ByteScannerTest, FindsMatchesAtEveryPositionAroundBlockEdges)
+{
+    std::string needle = "\r\n--b";
+    for (size_t size = needle.size(); size <= 100; ++size)
+    {
+        for (size_t at = 0; at + needle.size() <= size; ++at)
+        {
+            std::string haystack(size, '-'); // first and last byte of the needle never match together
+            haystack.replace(at, needle.size(), needle);
+            expectSameAsStringFind(haystack, needle);
+        }
+        expectSameAsStringFind(std::string(size, '-'), needle);
+    }
+}
+
+TEST(ByteScannerTest, AgreesWithStringFindOnRandomInput)
+{
+    std::mt19937 random(20);
+    std::uniform_int_distribution<int> letter(0, 3); // a small alphabet, so that partial matches are common
+    for (int round = 0; round < 2000; ++round)
+    {
+        std::string haystack(random() % 300, '\0');
+        for (char &c : haystack)
+            c = static_cast<char>('a' + letter(random));
+        std::string needle(1 + random() % 6, '\0');
+        for (char &c : needle)
+            c = static_cast<char>('a' + letter(random));
+        expectSameAsStringFind(haystack, needle);
+    }
+}
+
+TEST(ByteScannerTest, HandlesBytesAboveTheAsciiRange)
+{
+    std::string haystack;
+    for (int i = 0; i < 256; ++i)
+        haystack += static_cast<char>(i);
+    haystack += haystack;
+    expectSameAsStringFind(haystack, std::string("\xfe\xff\x00\x01", 4));
+    expectSameAsStringFind(haystack, std::string("\x80", 1));
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "../../src/Request/ChunkedDecoder.hpp"
+
+// Collects the decoded body
+class StringSink : public BodySink
+{
+public:
+    std::string data;
+
+    void append(const std::byte *bytes, size_t const &size) override
+    {
+        data.append(reinterpret_cast<const char *>(bytes), size);
+    }
+};
+
+// Feeds the input in reads of at most pieceSize bytes, like it comes off the socket
+static ChunkedDecoder::Status decodeInPieces(ChunkedDecoder &decoder, std::string const &input, size_t pieceSize,
+                                             StringSink &sink, size_t &consumedTotal)
+{
+    ChunkedDecoder::Status status = ChunkedDecoder::CHUNKED_INCOMPLETE;
+    consumedTotal = 0;
+    for (size_t offset = 0; offset < input.size(); offset += pieceSize)
+    {
+        size_t length = std::min(pieceSize, input.size() - offset);
+        size_t consumed = 0;
+        status = decoder.decode(reinterpret_cast<const std::byte *>(input.data() + offset), length, sink, consumed);
+        consumedTotal += consumed;
+        if (status != ChunkedDecoder::CHUNKED_INCOMPLETE)
+            break;
+        EXPECT_EQ(consumed, length);
+    }
+    return status;
+}
+
+static ChunkedDecoder::Status decodeWhole(std::string const &input, StringSink &sink,
+                                          size_t maxBodySize = std::numeric_limits<size_t>::max())
+{
+    ChunkedDecoder decoder(maxBodySize);
+    size_t consumed = 0;
+    return decodeInPieces(decoder, input, input.size(), sink, consumed);
+}
+
+TEST(ChunkedDecoderTest, DecodesWholeBody)
+{
+    ChunkedDecoder decoder;
+    StringSink sink;
+    size_t consumed = 0;
+    std::string body = "5\r\nhello\r\n7\r\n, world\r\n0\r\n\r\n";
+
+    EXPECT_EQ(decodeInPieces(decoder, body + "GET / HTTP/1.1\r\n", 4096, sink, consumed), ChunkedDecoder::CHUNKED_COMPLETE);
+    EXPECT_EQ(sink.data, "hello, world");
+    EXPECT_EQ(decoder.getDecodedSize(), 12u);
+    EXPECT_EQ(consumed, body.size()); // the pipelined request after it is left alone
+}
+
+TEST(ChunkedDecoderTest, DecodesInputSplitAcrossReads)
+{
+    std::string body = "1a;name=\"v\"\r\nabcdefghijklmnopqrstuvwxyz\r\n3\r\n\r\n\r\r\n0\r\nX-Sum: 1\r\n\r\n";
+
+    for (size_t pieceSize = 1; pieceSize <= body.size(); ++pieceSize)
+    {
+        ChunkedDecoder decoder;
+        StringSink sink;
+        size_t consumed = 0;
+        EXPECT_EQ(decodeInPieces(decoder, body, pieceSize, sink, consumed), ChunkedDecoder::CHUNKED_COMPLETE) << pieceSize;
+        EXPECT_EQ(sink.data, "abcdefghijklmnopqrstuvwxyz\r\n\r") << pieceSize;
+        EXPECT_EQ(consumed, body.size()) << pieceSize;
+    }
+}
+
+TEST(ChunkedDecoderTest, IgnoresChunkExtensions)
+{
+    StringSink sink;
+    EXPECT_EQ(decodeWhole("4;a=1;b=\"x y\"\r\nWiki\r\n5 ; ext\r\npedia\r\n0;last\r\n\r\n", sink), ChunkedDecoder::CHUNKED_COMPLETE);
+    EXPECT_EQ(sink.data, "Wikipedia");
+}
+
+TEST(ChunkedDecoderTest, DropsTrailerFields)
+{
+    StringSink sink;
+    EXPECT_EQ(decodeWhole("3\r\nabc\r\n0\r\nX-Checksum: 900150983cd24fb0\r\nX-Other:\r\n\r\n", sink), ChunkedDecoder::CHUNKED_COMPLETE);
+    EXPECT_EQ(sink.data, "abc");
+}
+
+TEST(ChunkedDecoderTest, WaitsForTheEndOfTheTrailerSection)
+{
+    StringSink sink;
+    EXPECT_EQ(decodeWhole("3\r\nabc\r\n0\r\n", sink), ChunkedDecoder::CHUNKED_INCOMPLETE);
+    EXPECT_EQ(decodeWhole("3\r\nabc\r\n0\r\nX-Sum: 1\r\n", sink), ChunkedDecoder::CHUNKED_INCOMPLETE);
+}
+
+TEST(ChunkedDecoderTest, RejectsBadChunkSize)
+{
+    StringSink sink;
+    EXPECT_EQ(decodeWhole("g\r\nabc\r\n0\r\n\r\n", sink), ChunkedDecoder::CHUNKED_BAD_SYNTAX);
+    EXPECT_EQ(decodeWhole("\r\nabc\r\n0\r\n\r\n", sink), ChunkedDecoder::CHUNKED_BAD_SYNTAX);
+    EXPECT_EQ(decodeWhole("-3\r\nabc\r\n0\r\n\r\n", sink), ChunkedDecoder::CHUNKED_BAD_SYNTAX);
+    EXPECT_EQ(decodeWhole("0x3\r\nabc\r\n0\r\n\r\n", sink), ChunkedDecoder::CHUNKED_BAD_SYNTAX);
+    EXPECT_EQ(decodeWhole(";ext\r\nabc\r\n0\r\n\r\n", sink), ChunkedDecoder::CHUNKED_BAD_SYNTAX);
+    EXPECT_EQ(decodeWhole("3\nabc\r\n0\r\n\r\n", sink), ChunkedDecoder::CHUNKED_BAD_SYNTAX);
+}
+
+TEST(ChunkedDecoderTest, RejectsMissingCrlfAfterData)
+{
+    StringSink sink;
+    EXPECT_EQ(decodeWhole("3\r\nabcd\r\n0\r\n\r\n", sink), ChunkedDecoder::CHUNKED_BAD_SYNTAX);
+    EXPECT_EQ(decodeWhole("3\r\nabc\n0\r\n\r\n", sink), ChunkedDecoder::CHUNKED_BAD_SYNTAX);
+}
+
+TEST(ChunkedDecoderTest, RejectsBadTrailerAndOverlongLines)
+{
+    StringSink sink;
+    EXPECT_EQ(decodeWhole("0\r\n: value\r\n\r\n", sink), ChunkedDecoder::CHUNKED_BAD_SYNTAX);
+    EXPECT_EQ(decodeWhole("0\r\n\r\r\n", sink), ChunkedDecoder::CHUNKED_BAD_SYNTAX);
+    EXPECT_EQ(decodeWhole("3;" + std::string(CHUNKED_MAX_LINE_LENGTH, 'a') + "\r\nabc\r\n0\r\n\r\n", sink), ChunkedDecoder::CHUNKED_BAD_SYNTAX);
+}
+
+TEST(ChunkedDecoderTest, RejectsBodyOverTheLimit)
+{
+    StringSink sink;
+    EXPECT_EQ(decodeWhole("5\r\nhello\r\n5\r\nworld\r\n0\r\n\r\n", sink, 10), ChunkedDecoder::CHUNKED_COMPLETE);
+    EXPECT_EQ(decodeWhole("5\r\nhello\r\n6\r\nworld!\r\n0\r\n\r\n", sink, 10), ChunkedDecoder::CHUNKED_TOO_LARGE);
+    EXPECT_EQ(decodeWhole("ffffffffffffffffffff\r\n", sink), ChunkedDecoder::CHUNKED_TOO_LARGE); // would overflow
+}
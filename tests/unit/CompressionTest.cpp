@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <string>
+#include <cstdio>
+#include "../../src/Utils/Compression.hpp"
+
+static std::vector<std::byte> toBytes(std::string const &text)
+{
+    const std::byte *data = reinterpret_cast<const std::byte *>(text.data());
+    return std::vector<std::byte>(data, data + text.size());
+}
+
+// what a client gets back from the gzip body
+static std::string gunzip(std::vector<std::byte> const &compressed)
+{
+    z_stream stream = {};
+    EXPECT_EQ(inflateInit2(&stream, MAX_WBITS + 16), Z_OK);
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<std::byte *>(compressed.data()));
+    stream.avail_in = compressed.size();
+    std::string output;
+    char chunk[4096];
+    int result;
+    do
+    {
+        stream.next_out = reinterpret_cast<Bytef *>(chunk);
+        stream.avail_out = sizeof(chunk);
+        result = inflate(&stream, Z_NO_FLUSH);
+        output.append(chunk, sizeof(chunk) - stream.avail_out);
+    } while (result == Z_OK);
+    EXPECT_EQ(result, Z_STREAM_END);
+    inflateEnd(&stream);
+    return output;
+}
+
+static std::string sampleText(size_t size)
+{
+    std::string text;
+    for (size_t i = 0; text.size() < size; ++i)
+        text += "line " + std::to_string(i % 97) + " of some compressible text\n";
+    return text.substr(0, size);
+}
+
+class CompressionFileTest : public ::testing::Test
+{
+protected:
+    std::string path = "configs/test_files/test_Compression.txt";
+
+    void TearDown() override
+    {
+        std::remove(path.c_str());
+    }
+
+    void writeFile(std::string const &content)
+    {
+        std::ofstream file(path, std::ios::trunc | std::ios::binary);
+        file << content;
+    }
+};
+
+TEST(CompressionTest, GzipsAcrossSeveralChunks)
+{
+    std::string text = sampleText(3 * GZIP_CHUNK_SIZE + 123);
+    std::vector<std::byte> compressed = Compression::gzip(toBytes(text));
+    EXPECT_LT(compressed.size(), text.size());
+    EXPECT_EQ(gunzip(compressed), text);
+}
+
+TEST(CompressionTest, GzipsEmptyInput)
+{
+    EXPECT_EQ(gunzip(Compression::gzip({})), "");
+}
+
+TEST_F(CompressionFileTest, GzipsTheFileLikeItsContent)
+{
+    std::string text = sampleText(2 * GZIP_CHUNK_SIZE + 7);
+    writeFile(text);
+    OpenFile file(path);
+    EXPECT_EQ(gunzip(Compression::gzipFile(file, text.size())), text);
+}
+
+TEST_F(CompressionFileTest, RefusesFilesOverTheLimit)
+{
+    writeFile(sampleText(1000));
+    OpenFile file(path);
+    EXPECT_THROW(Compression::gzipFile(file, 999), std::runtime_error);
+}
@@ -0,0 +1,79 @@
+#include <sys/stat.h>
+#include <sstream>
+#include "StaticFileTest.hpp"
+
+class ConditionalRequestTest : public StaticFileTest
+{
+protected:
+    // the ETag the server gives the file: inode, mtime and size in hex
+    std::string strongTag() const
+    {
+        struct stat fileStat;
+        EXPECT_EQ(stat(filePath.c_str(), &fileStat), 0);
+        std::stringstream tag;
+        tag << std::hex << '"' << fileStat.st_ino << '-' << fileStat.st_mtime << '-' << fileStat.st_size << '"';
+        return tag.str();
+    }
+};
+
+TEST_F(ConditionalRequestTest, SendsValidatorsWithTheFile)
+{
+    Request req = request();
+    Response response(req);
+    EXPECT_EQ(response.getStatusCode(), HttpStatusCode::OK);
+    EXPECT_EQ(header(response, "ETag"), strongTag());
+    EXPECT_FALSE(header(response, "Last-Modified").empty());
+    EXPECT_EQ(header(response, "Accept-Ranges"), "bytes");
+}
+
+TEST_F(ConditionalRequestTest, AnswersAMatchingIfNoneMatchWith304)
+{
+    std::string const matching[] = {strongTag(), "W/" + strongTag(), "\"other\", " + strongTag(), "*"};
+    for (std::string const &tags : matching)
+    {
+        Request req = request("If-None-Match: " + tags);
+        Response response(req);
+        EXPECT_EQ(response.getStatusCode(), HttpStatusCode::NOT_MODIFIED) << tags;
+        EXPECT_EQ(header(response, "ETag"), strongTag()) << tags;
+        EXPECT_EQ(response.takeBodyFile(), nullptr) << tags;
+    }
+    Request other = request("If-None-Match: \"other\"");
+    EXPECT_EQ(Response(other).getStatusCode(), HttpStatusCode::OK);
+}
+
+TEST_F(ConditionalRequestTest, ComparesIfModifiedSinceWithTheFileDate)
+{
+    Request plain = request();
+    std::string lastModified = header(Response(plain), "Last-Modified");
+
+    Request same = request("If-Modified-Since: " + lastModified);
+    EXPECT_EQ(Response(same).getStatusCode(), HttpStatusCode::NOT_MODIFIED);
+    Request later = request("If-Modified-Since: Fri, 01 Jan 2100 00:00:00 GMT");
+    EXPECT_EQ(Response(later).getStatusCode(), HttpStatusCode::NOT_MODIFIED);
+    Request earlier = request("If-Modified-Since: Thu, 01 Jan 1970 00:00:00 GMT");
+    EXPECT_EQ(Response(earlier).getStatusCode(), HttpStatusCode::OK);
+    Request garbage = request("If-Modified-Since: yesterday");
+    EXPECT_EQ(Response(garbage).getStatusCode(), HttpStatusCode::OK);
+}
+
+TEST_F(ConditionalRequestTest, PrefersIfNoneMatchOverIfModifiedSince)
+{
+    Request req = request("If-None-Match: \"other\"\r\nIf-Modified-Since: Fri, 01 Jan 2100 00:00:00 GMT");
+    EXPECT_EQ(Response(req).getStatusCode(), HttpStatusCode::OK);
+}
+
+TEST_F(ConditionalRequestTest, AnswersHeadLikeGet)
+{
+    Request req = request("If-None-Match: " + strongTag(), "HEAD");
+    EXPECT_EQ(Response(req).getStatusCode(), HttpStatusCode::NOT_MODIFIED);
+}
+
+TEST_F(ConditionalRequestTest, LetsRangesThroughOnAStrongIfRangeTag)
+{
+    Request strong = request("Range: bytes=0-0\r\nIf-Range: " + strongTag());
+    EXPECT_EQ(Response(strong).getStatusCode(), HttpStatusCode::PARTIAL_CONTENT);
+    Request weak = request("Range: bytes=0-0\r\nIf-Range: W/" + strongTag());
+    EXPECT_EQ(Response(weak).getStatusCode(), HttpStatusCode::OK);
+    Request other = request("Range: bytes=0-0\r\nIf-Range: \"other\"");
+    EXPECT_EQ(Response(other).getStatusCode(), HttpStatusCode::OK);
+}
@@ -66,6 +66,26 @@ void ConfigParserTest::ExpectThrowsFromFile(
     }
 }
 
+// Writes the content to a test file and parses it, the file is removed again before returning
+std::unique_ptr<ConfigParser> ConfigParserTest::ParseConfig(
+    const std::string &testName,
+    const std::string &configContent)
+{
+    std::string testFilePath = "configs/test_files/test_" + testName + ".conf";
+    TestConfigFile testFile(testFilePath, configContent);
+    std::unique_ptr<ConfigParser> parser(new ConfigParser(testFilePath));
+    parser->extractServerConfigs();
+    return parser;
+}
+
+// A server block on port 10001 with the given directives, each line ending in a newline
+std::string ConfigParserTest::ServerBlock(const std::string &directives)
+{
+    return "server {\n"
+           "    listen 10001;\n" +
+           directives + "}\n";
+}
+
 // TestConfigFile implementation
 TestConfigFile::TestConfigFile(const std::string &path, const std::string &content) : filePath(path)
 {
@@ -109,6 +129,251 @@ TEST_F(ConfigParserTest, ThrowsOnInvalidConfig)
     EXPECT_THROW({ ExpectThrowsFromFile("InvalidConfig", invalidConfigPath); }, std::runtime_error);
 }
 
+TEST_F(ConfigParserTest, ParsesGlobalEventEngine)
+{
+    std::unique_ptr<ConfigParser> parser = ParseConfig("EventEngine", "event_engine poll;\n" + ServerBlock(""));
+    EXPECT_EQ(parser->getGlobalConfig().getEventEngine(), EventEngine::ENGINE_POLL);
+    EXPECT_EQ(validParser->getGlobalConfig().getEventEngine(), DefaultValues::EVENT_ENGINE);
+}
+
+TEST_F(ConfigParserTest, ThrowsOnInvalidEventEngine)
+{
+    EXPECT_THROW({ ExpectThrowsWithMessage("InvalidEventEngine", "event_engine select;\n" + ServerBlock("")); }, std::runtime_error);
+}
+
+TEST_F(ConfigParserTest, ParsesWorkerThreads)
+{
+    std::unique_ptr<ConfigParser> parser = ParseConfig("WorkerThreads", "worker_threads 4;\n" + ServerBlock(""));
+    EXPECT_EQ(parser->getGlobalConfig().getWorkerThreads(), 4);
+    EXPECT_EQ(validParser->getGlobalConfig().getWorkerThreads(), DefaultValues::WORKER_THREADS);
+}
+
+TEST_F(ConfigParserTest, ThrowsOnInvalidWorkerThreads)
+{
+    EXPECT_THROW({ ExpectThrowsWithMessage("InvalidWorkerThreads", "worker_threads 0;\n" + ServerBlock("")); }, std::runtime_error);
+}
+
+TEST_F(ConfigParserTest, ParsesClientTimeouts)
+{
+    std::unique_ptr<ConfigParser> parser = ParseConfig("ClientTimeouts", ServerBlock("    client_header_timeout 500ms;\n"
+                                                                                     "    client_body_timeout 30;\n"
+                                                                                     "    keepalive_timeout 2m;\n"));
+    ConfigData config = parser->getServerConfigs().front();
+    EXPECT_EQ(config.getTimeoutMs(CLIENT_HEADER_TIMEOUT), 500U);
+    EXPECT_EQ(config.getTimeoutMs(CLIENT_BODY_TIMEOUT), 30000U);
+    EXPECT_EQ(config.getTimeoutMs(KEEPALIVE_TIMEOUT), 120000U);
+    EXPECT_EQ(config.getTimeoutMs(SEND_TIMEOUT), DefaultValues::TIMEOUT_MS);
+}
+
+TEST_F(ConfigParserTest, ThrowsOnInvalidClientTimeout)
+{
+    EXPECT_THROW({ ExpectThrowsWithMessage("InvalidClientTimeout", ServerBlock("    send_timeout 10h;\n")); }, std::runtime_error);
+}
+
+TEST_F(ConfigParserTest, ParsesAcceptBudget)
+{
+    std::unique_ptr<ConfigParser> parser = ParseConfig("AcceptBudget", "accept_budget 128;\n" + ServerBlock(""));
+    EXPECT_EQ(parser->getGlobalConfig().getAcceptBudget(), 128);
+    EXPECT_EQ(validParser->getGlobalConfig().getAcceptBudget(), DefaultValues::ACCEPT_BUDGET);
+    EXPECT_THROW({ ExpectThrowsWithMessage("InvalidAcceptBudget", "accept_budget 0;\n" + ServerBlock("")); }, std::runtime_error);
+}
+
+TEST_F(ConfigParserTest, ParsesMaxConnections)
+{
+    std::unique_ptr<ConfigParser> parser = ParseConfig("MaxConnections", "max_connections 1000;\n" + ServerBlock("    max_connections 200;\n"));
+    EXPECT_EQ(parser->getGlobalConfig().getMaxConnections(), 1000U);
+    EXPECT_EQ(parser->getServerConfigs().front().getMaxConnections(), 200U);
+    EXPECT_EQ(validParser->getGlobalConfig().getMaxConnections(), DefaultValues::MAX_CONNECTIONS);
+    EXPECT_THROW({ ExpectThrowsWithMessage("InvalidMaxConnections", ServerBlock("    max_connections -1;\n")); }, std::runtime_error);
+}
+
+TEST_F(ConfigParserTest, ThrowsOnConflictingListenerMaxConnections)
+{
+    // a block without the directive shares the limit
+    EXPECT_NO_THROW(ParseConfig("SharedMaxConnections", ServerBlock("    server_name a.com;\n"
+                                                                    "    max_connections 100;\n") +
+                                                            ServerBlock("    server_name b.com;\n")));
+    EXPECT_THROW({ ExpectThrowsWithMessage("ConflictingMaxConnections", ServerBlock("    server_name a.com;\n"
+                                                                                    "    max_connections 100;\n") +
+                                                                            ServerBlock("    server_name b.com;\n"
+                                                                                        "    max_connections 200;\n")); }, std::runtime_error);
+}
+
+TEST_F(ConfigParserTest, ParsesLocationSendFile)
+{
+    std::unique_ptr<ConfigParser> parser = ParseConfig("SendFile", ServerBlock("    location / {\n"
+                                                                               "        root /pages;\n"
+                                                                               "    }\n"
+                                                                               "    location /upload {\n"
+                                                                               "        root /pages;\n"
+                                                                               "        sendfile off;\n"
+                                                                               "    }\n"));
+    ConfigData config = parser->getServerConfigs().front();
+    EXPECT_TRUE(config.getMatchingLocation("/").getSendFile());
+    EXPECT_FALSE(config.getMatchingLocation("/upload").getSendFile());
+    EXPECT_FALSE(config.getMatchingLocation("/upload/big.bin").getSendFile()); // requests below the location inherit it
+    EXPECT_TRUE(config.getMatchingLocation("/uploads").getSendFile());         // a longer name is not below it
+}
+
+TEST_F(ConfigParserTest, ParsesLocationGzipStatic)
+{
+    std::unique_ptr<ConfigParser> parser = ParseConfig("GzipStatic", ServerBlock("    location / {\n"
+                                                                                 "        root /pages;\n"
+                                                                                 "        gzip_static on;\n"
+                                                                                 "    }\n"
+                                                                                 "    location /upload {\n"
+                                                                                 "        root /pages;\n"
+                                                                                 "    }\n"));
+    ConfigData config = parser->getServerConfigs().front();
+    EXPECT_TRUE(config.getMatchingLocation("/").getGzipStatic());
+    EXPECT_TRUE(config.getMatchingLocation("/style.css").getGzipStatic());
+    EXPECT_FALSE(config.getMatchingLocation("/upload").getGzipStatic()); // the longest matching location wins
+    EXPECT_FALSE(config.getMatchingLocation("/upload/a.txt").getGzipStatic());
+}
+
+TEST_F(ConfigParserTest, ParsesLocationGzip)
+{
+    std::unique_ptr<ConfigParser> parser = ParseConfig("Gzip", ServerBlock("    location / {\n"
+                                                                           "        root /pages;\n"
+                                                                           "        gzip on;\n"
+                                                                           "        gzip_types text/css application/json;\n"
+                                                                           "        gzip_min_length 1000;\n"
+                                                                           "    }\n"));
+    Location location = parser->getServerConfigs().front().getMatchingLocation("/");
+    EXPECT_TRUE(location.getGzip());
+    EXPECT_EQ(location.getGzipTypes().size(), 3U); // text/html is always compressed
+    EXPECT_EQ(location.getGzipTypes().count(ContentType::APPLICATION_JSON), 1U);
+    EXPECT_EQ(location.getGzipMinLength(), 1000U);
+    EXPECT_FALSE(location.getGzipStatic());
+}
+
+TEST_F(ConfigParserTest, DefaultsAndRejectsLocationGzip)
+{
+    std::unique_ptr<ConfigParser> parser = ParseConfig("GzipDefaults", ServerBlock("    location / {\n"
+                                                                                   "        root /pages;\n"
+                                                                                   "        gzip_static on;\n" // must not switch gzip on
+                                                                                   "    }\n"));
+    Location location = parser->getServerConfigs().front().getMatchingLocation("/");
+    EXPECT_FALSE(location.getGzip());
+    EXPECT_EQ(location.getGzipTypes().size(), 1U);
+    EXPECT_EQ(location.getGzipTypes().count(ContentType::TEXT_HTML), 1U);
+    EXPECT_EQ(location.getGzipMinLength(), static_cast<size_t>(DEFAULT_GZIP_MIN_LENGTH));
+    EXPECT_THROW({ ExpectThrowsWithMessage("InvalidGzipType", ServerBlock("    location / {\n"
+                                                                          "        root /pages;\n"
+                                                                          "        gzip_types text/nope;\n"
+                                                                          "    }\n")); }, std::runtime_error);
+    EXPECT_THROW({ ExpectThrowsWithMessage("InvalidGzipMinLength", ServerBlock("    location / {\n"
+                                                                               "        root /pages;\n"
+                                                                               "        gzip_min_length 1k;\n"
+                                                                               "    }\n")); }, std::runtime_error);
+}
+
+TEST_F(ConfigParserTest, ParsesLocationMaxBodySize)
+{
+    std::unique_ptr<ConfigParser> parser = ParseConfig("LocationMaxBodySize", ServerBlock("    client_max_body_size 10M;\n"
+                                                                                          "    location / {\n"
+                                                                                          "        root /pages;\n"
+                                                                                          "    }\n"
+                                                                                          "    location /upload {\n"
+                                                                                          "        root /pages;\n"
+                                                                                          "        client_max_body_size 1k;\n"
+                                                                                          "    }\n"));
+    ConfigData config = parser->getServerConfigs().front();
+    EXPECT_EQ(config.getMaxClientBodySize(), 10U * 1024 * 1024);
+    EXPECT_EQ(config.getMatchingLocation("/").getMaxBodySize(), 10U * 1024 * 1024);
+    EXPECT_EQ(config.getMatchingLocation("/upload").getMaxBodySize(), 1024U);
+    EXPECT_EQ(config.getMatchingLocation("/upload/a.bin").getMaxBodySize(), 1024U);
+}
+
+TEST_F(ConfigParserTest, DefaultsAndRejectsLocationMaxBodySize)
+{
+    // a location only setting its own limit leaves the server default alone
+    std::unique_ptr<ConfigParser> parser = ParseConfig("LocationMaxBodySizeDefault", ServerBlock("    location / {\n"
+                                                                                                 "        root /pages;\n"
+                                                                                                 "    }\n"
+                                                                                                 "    location /upload {\n"
+                                                                                                 "        root /pages;\n"
+                                                                                                 "        client_max_body_size 2m;\n"
+                                                                                                 "    }\n"));
+    ConfigData config = parser->getServerConfigs().front();
+    EXPECT_EQ(config.getMaxClientBodySize(), static_cast<size_t>(DefaultValues::MAX_CLIENT_BODY_SIZE));
+    EXPECT_EQ(config.getMatchingLocation("/").getMaxBodySize(), static_cast<size_t>(DefaultValues::MAX_CLIENT_BODY_SIZE));
+    EXPECT_EQ(config.getMatchingLocation("/upload").getMaxBodySize(), 2U * 1024 * 1024);
+    EXPECT_THROW({ ExpectThrowsWithMessage("InvalidLocationMaxBodySize", ServerBlock("    location /upload {\n"
+                                                                                     "        root /pages;\n"
+                                                                                     "        client_max_body_size 1x;\n"
+                                                                                     "    }\n")); }, std::runtime_error);
+}
+
+TEST_F(ConfigParserTest, ParsesOpenFileCache)
+{
+    std::unique_ptr<ConfigParser> parser = ParseConfig("OpenFileCache", "open_file_cache 500;\n"
+                                                                        "open_file_cache_valid 30s;\n"
+                                                                        "open_file_cache_errors on;\n" +
+                                                                            ServerBlock(""));
+    EXPECT_EQ(parser->getGlobalConfig().getOpenFileCache(), 500U);
+    EXPECT_EQ(parser->getGlobalConfig().getOpenFileCacheValidMs(), 30000U);
+    EXPECT_TRUE(parser->getGlobalConfig().getOpenFileCacheErrors());
+    EXPECT_EQ(validParser->getGlobalConfig().getOpenFileCache(), DefaultValues::OPEN_FILE_CACHE);
+    EXPECT_EQ(validParser->getGlobalConfig().getOpenFileCacheValidMs(), DefaultValues::OPEN_FILE_CACHE_VALID_MS);
+    EXPECT_FALSE(validParser->getGlobalConfig().getOpenFileCacheErrors());
+}
+
+TEST_F(ConfigParserTest, ThrowsOnInvalidOpenFileCache)
+{
+    EXPECT_NO_THROW(ParseConfig("DisabledOpenFileCache", "open_file_cache 0;\n" + ServerBlock("")));
+    EXPECT_THROW({ ExpectThrowsWithMessage("OpenFileCacheOutOfRange", "open_file_cache 65537;\n" + ServerBlock("")); }, std::runtime_error);
+    EXPECT_THROW({ ExpectThrowsWithMessage("InvalidOpenFileCache", "open_file_cache 1k;\n" + ServerBlock("")); }, std::runtime_error);
+    EXPECT_THROW({ ExpectThrowsWithMessage("InvalidOpenFileCacheValid", "open_file_cache_valid 1h;\n" + ServerBlock("")); }, std::runtime_error);
+    EXPECT_THROW({ ExpectThrowsWithMessage("InvalidOpenFileCacheErrors", "open_file_cache_errors yes;\n" + ServerBlock("")); }, std::runtime_error);
+}
+
+TEST_F(ConfigParserTest, ParsesContentCache)
+{
+    std::unique_ptr<ConfigParser> parser = ParseConfig("ContentCache", "content_cache_size 32m;\n"
+                                                                       "content_cache_max_file_size 128k;\n" +
+                                                                           ServerBlock(""));
+    EXPECT_EQ(parser->getGlobalConfig().getContentCacheSize(), 32U * 1024 * 1024);
+    EXPECT_EQ(parser->getGlobalConfig().getContentCacheMaxFileSize(), 128U * 1024);
+    EXPECT_EQ(validParser->getGlobalConfig().getContentCacheSize(), DefaultValues::CONTENT_CACHE_SIZE);
+    EXPECT_EQ(validParser->getGlobalConfig().getContentCacheMaxFileSize(), DefaultValues::CONTENT_CACHE_MAX_FILE_SIZE);
+}
+
+TEST_F(ConfigParserTest, ThrowsOnInvalidContentCache)
+{
+    EXPECT_NO_THROW(ParseConfig("DisabledContentCache", "content_cache_size 0;\n" + ServerBlock("")));
+    EXPECT_THROW({ ExpectThrowsWithMessage("ContentCacheOutOfRange", "content_cache_size 2g;\n" + ServerBlock("")); }, std::runtime_error);
+    EXPECT_THROW({ ExpectThrowsWithMessage("InvalidContentCacheSize", "content_cache_size 32x;\n" + ServerBlock("")); }, std::runtime_error);
+    EXPECT_THROW({ ExpectThrowsWithMessage("ZeroContentCacheMaxFileSize", "content_cache_max_file_size 0;\n" + ServerBlock("")); }, std::runtime_error);
+}
+
+TEST_F(ConfigParserTest, ParsesStreamWindowSize)
+{
+    std::unique_ptr<ConfigParser> parser = ParseConfig("StreamWindowSize", ServerBlock("    stream_window_size 256k;\n"));
+    EXPECT_EQ(parser->getServerConfigs().front().getStreamWindowSize(), 256U * 1024);
+    EXPECT_EQ(configs[0].getStreamWindowSize(), DefaultValues::STREAM_WINDOW_SIZE);
+    EXPECT_THROW({ ExpectThrowsWithMessage("InvalidStreamWindowSize", ServerBlock("    stream_window_size 10g;\n")); }, std::runtime_error);
+    EXPECT_THROW({ ExpectThrowsWithMessage("TooSmallStreamWindowSize", ServerBlock("    stream_window_size 1k;\n")); }, std::runtime_error);
+}
+
+TEST_F(ConfigParserTest, ParsesClientMaxHeaderSize)
+{
+    std::unique_ptr<ConfigParser> parser = ParseConfig("ClientMaxHeaderSize", ServerBlock("    client_max_header_size 32k;\n"));
+    EXPECT_EQ(parser->getServerConfigs().front().getMaxHeaderSize(), 32U * 1024);
+    EXPECT_EQ(configs[0].getMaxHeaderSize(), DefaultValues::CLIENT_MAX_HEADER_SIZE);
+    EXPECT_THROW({ ExpectThrowsWithMessage("InvalidClientMaxHeaderSize", ServerBlock("    client_max_header_size 100;\n")); }, std::runtime_error);
+    EXPECT_THROW({ ExpectThrowsWithMessage("TooLargeClientMaxHeaderSize", ServerBlock("    client_max_header_size 2m;\n")); }, std::runtime_error);
+}
+
+TEST_F(ConfigParserTest, ParsesClientBodyBufferSize)
+{
+    std::unique_ptr<ConfigParser> parser = ParseConfig("ClientBodyBufferSize", ServerBlock("    client_body_buffer_size 64k;\n"));
+    EXPECT_EQ(parser->getServerConfigs().front().getBodyBufferSize(), 64U * 1024);
+    EXPECT_EQ(configs[0].getBodyBufferSize(), DefaultValues::CLIENT_BODY_BUFFER_SIZE);
+    EXPECT_THROW({ ExpectThrowsWithMessage("InvalidClientBodyBufferSize", ServerBlock("    client_body_buffer_size 2g;\n")); }, std::runtime_error);
+    EXPECT_THROW({ ExpectThrowsWithMessage("TooSmallClientBodyBufferSize", ServerBlock("    client_body_buffer_size 512;\n")); }, std::runtime_error);
+}
+
 // TEST_F(ConfigParserTest, ParsesServerPort)
 // {
 //     ASSERT_GT(configs.size(), 0U);
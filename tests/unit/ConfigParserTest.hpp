@@ -7,6 +7,7 @@
 #include <gtest/gtest.h>
 // #include <string>
 #include <exception>
+#include <memory>
 
 class ConfigParserTest : public ::testing::Test
 {
@@ -30,6 +31,11 @@ protected:
 
     void ExpectThrowsFromFile(
         const std::string &description, std::string &filePath);
+
+    // Helpers for tests that parse an inline config
+    std::unique_ptr<ConfigParser> ParseConfig(const std::string &testName,
+                                              const std::string &configContent);
+    static std::string ServerBlock(const std::string &directives);
 };
 
 class TestConfigFile
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <netinet/in.h>
+#include "../../src/Server/ConnectionTable.hpp"
+
+// The table never touches the fds themselves, so plain numbers stand in for sockets
+class ConnectionTableTest : public ::testing::Test
+{
+protected:
+    ConnectionTable table;
+    Server server{ConfigData()};
+
+    static std::unique_ptr<Client> makeClient(int const &fd)
+    {
+        return std::make_unique<Client>(fd, sockaddr_in());
+    }
+};
+
+TEST_F(ConnectionTableTest, FindsClientsByFd)
+{
+    std::unique_ptr<Client> client = makeClient(5);
+    Client *clientPtr = client.get();
+    ConnectionTable::Connection *connection = table.addClient(server, client);
+
+    ASSERT_NE(connection, nullptr);
+    EXPECT_EQ(client, nullptr); // the table owns it now
+    EXPECT_EQ(table.find(5), connection);
+    EXPECT_EQ(connection->type, ConnectionTable::CLIENT_SLOT);
+    EXPECT_EQ(connection->client.get(), clientPtr);
+    EXPECT_EQ(connection->server, &server);
+    EXPECT_EQ(connection->timeout, CLIENT_HEADER_TIMEOUT);
+    EXPECT_EQ(table.find(4), nullptr);
+    EXPECT_EQ(table.find(-1), nullptr);
+    EXPECT_EQ(table.getClientCount(), 1U);
+}
+
+TEST_F(ConnectionTableTest, ReleaseBumpsTheGeneration)
+{
+    std::unique_ptr<Client> client = makeClient(6);
+    uint32_t firstGeneration = table.addClient(server, client)->generation;
+    table.release(6);
+    EXPECT_EQ(table.find(6), nullptr);
+    EXPECT_EQ(table.getClientCount(), 0U);
+
+    // the kernel hands the same fd to the next connection, events queued for the old one no longer match
+    std::unique_ptr<Client> next = makeClient(6);
+    ConnectionTable::Connection *connection = table.addClient(server, next);
+    ASSERT_NE(connection, nullptr);
+    EXPECT_NE(connection->generation, firstGeneration);
+    EXPECT_EQ(connection->generation, firstGeneration + 1);
+
+    table.release(6);
+    table.release(6); // a second release of a free slot changes nothing
+    std::unique_ptr<Client> third = makeClient(6);
+    EXPECT_EQ(table.addClient(server, third)->generation, firstGeneration + 2);
+}
+
+TEST_F(ConnectionTableTest, KeepsListenersApartFromClients)
+{
+    ASSERT_TRUE(table.addListener(3, server));
+    std::unique_ptr<Client> client = makeClient(8);
+    table.addClient(server, client);
+
+    ASSERT_NE(table.find(3), nullptr);
+    EXPECT_EQ(table.find(3)->type, ConnectionTable::LISTENER_SLOT);
+    EXPECT_EQ(table.getClientCount(), 1U);
+    EXPECT_EQ(table.getClientFds(), std::vector<int>({8}));
+    table.release(3);
+    EXPECT_EQ(table.find(3), nullptr);
+    EXPECT_EQ(table.getClientCount(), 1U);
+}
+
+TEST_F(ConnectionTableTest, LeavesFdsOutsideTheTableToTheCaller)
+{
+    int fd = static_cast<int>(table.getCapacity());
+    std::unique_ptr<Client> client = makeClient(fd);
+    EXPECT_EQ(table.addClient(server, client), nullptr);
+    EXPECT_NE(client, nullptr);
+    EXPECT_FALSE(table.addListener(fd, server));
+    EXPECT_EQ(table.find(fd), nullptr);
+    EXPECT_EQ(table.getClientCount(), 0U);
+}
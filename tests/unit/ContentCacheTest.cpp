@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <string>
+#include <cstdio>
+#include "../../src/Utils/ContentCache.hpp"
+
+// The cache of the test thread, with files written next to the test configs
+class ContentCacheTest : public ::testing::Test
+{
+protected:
+    std::string paths[3] = {"configs/test_files/test_ContentCache0.txt", "configs/test_files/test_ContentCache1.txt",
+                            "configs/test_files/test_ContentCache2.txt"};
+
+    void SetUp() override
+    {
+        ContentCache::getInstance().configure(100, 50);
+    }
+
+    void TearDown() override
+    {
+        ContentCache::getInstance().configure(0, 0);
+        for (std::string const &path : paths)
+            std::remove(path.c_str());
+    }
+
+    static OpenFile writeFile(std::string const &path, std::string const &content)
+    {
+        std::ofstream file(path, std::ios::trunc | std::ios::binary);
+        file << content;
+        file.close();
+        return OpenFile(path);
+    }
+
+    static std::string text(ContentCache::Buffer const &buffer)
+    {
+        return std::string(reinterpret_cast<const char *>(buffer->data()), buffer->size());
+    }
+};
+
+TEST_F(ContentCacheTest, SharesOneBufferPerFile)
+{
+    ContentCache &cache = ContentCache::getInstance();
+    OpenFile file = writeFile(paths[0], "cached content");
+    ContentCache::Buffer first = cache.get(paths[0], file);
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(text(first), "cached content");
+    EXPECT_EQ(cache.get("/" + paths[0], file), first);
+    EXPECT_EQ(cache.size(), first->size()); // bytes cached
+}
+
+TEST_F(ContentCacheTest, SkipsFilesOverTheLimits)
+{
+    ContentCache &cache = ContentCache::getInstance();
+    OpenFile large = writeFile(paths[0], std::string(51, 'x'));
+    EXPECT_EQ(cache.get(paths[0], large), nullptr);
+    EXPECT_EQ(cache.getGzipped(paths[0], large), nullptr);
+
+    cache.configure(0, 50); // off
+    OpenFile small = writeFile(paths[1], "small");
+    EXPECT_EQ(cache.get(paths[1], small), nullptr);
+    EXPECT_EQ(cache.size(), 0U);
+}
+
+TEST_F(ContentCacheTest, DropsTheLeastRecentlyUsedWhenTheBudgetIsFull)
+{
+    ContentCache &cache = ContentCache::getInstance();
+    OpenFile first = writeFile(paths[0], std::string(40, 'a'));
+    OpenFile second = writeFile(paths[1], std::string(40, 'b'));
+    OpenFile third = writeFile(paths[2], std::string(40, 'c'));
+    ContentCache::Buffer firstBuffer = cache.get(paths[0], first);
+    ContentCache::Buffer secondBuffer = cache.get(paths[1], second);
+    cache.get(paths[0], first); // the first one is now the most recently used
+    cache.get(paths[2], third); // 120 bytes do not fit in 100, the second one goes
+
+    EXPECT_EQ(cache.size(), 80U);
+    EXPECT_EQ(cache.get(paths[0], first), firstBuffer);
+    EXPECT_EQ(text(secondBuffer), std::string(40, 'b')); // still valid for whoever holds it
+    EXPECT_NE(cache.get(paths[1], second), secondBuffer);
+}
+
+TEST_F(ContentCacheTest, RereadsAFileThatChanged)
+{
+    ContentCache &cache = ContentCache::getInstance();
+    OpenFile before = writeFile(paths[0], "before");
+    ContentCache::Buffer old = cache.get(paths[0], before);
+    OpenFile after = writeFile(paths[0], "after the change");
+    EXPECT_EQ(text(cache.get(paths[0], after)), "after the change");
+    EXPECT_EQ(text(old), "before");
+}
+
+TEST_F(ContentCacheTest, InvalidateDropsThePlainAndGzippedContent)
+{
+    ContentCache &cache = ContentCache::getInstance();
+    OpenFile file = writeFile(paths[0], std::string(30, 'z'));
+    ContentCache::Buffer plain = cache.get(paths[0], file);
+    ContentCache::Buffer gzipped = cache.getGzipped(paths[0], file);
+    ASSERT_NE(gzipped, nullptr);
+    EXPECT_NE(gzipped, plain);
+    EXPECT_EQ(cache.getGzipped(paths[0], file), gzipped); // compressed once
+    EXPECT_EQ(cache.size(), plain->size() + gzipped->size());
+
+    cache.invalidate(paths[0]);
+    EXPECT_EQ(cache.size(), 0U);
+    EXPECT_NE(cache.get(paths[0], file), plain);
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include "../../src/Server/InputBuffer.hpp"
+
+// The client writes on one end of a socket pair, the buffer receives from the other
+class InputBufferTest : public ::testing::Test
+{
+protected:
+    int sockets[2] = {-1, -1};
+
+    void SetUp() override
+    {
+        ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0);
+        fcntl(sockets[0], F_SETFL, O_NONBLOCK);
+    }
+
+    void TearDown() override
+    {
+        close(sockets[0]);
+        close(sockets[1]);
+    }
+
+    void sendFromClient(std::string const &data)
+    {
+        ASSERT_EQ(send(sockets[1], data.data(), data.size(), 0), static_cast<ssize_t>(data.size()));
+    }
+
+    // receive until the socket has nothing more
+    static void receiveAll(InputBuffer &buffer, int const &fd)
+    {
+        while (buffer.receiveFrom(fd) > 0)
+            ;
+    }
+
+    static std::string unconsumed(InputBuffer const &buffer)
+    {
+        return std::string(buffer.peek(), buffer.size());
+    }
+};
+
+TEST_F(InputBufferTest, ConsumesFromTheFront)
+{
+    InputBuffer buffer;
+    EXPECT_TRUE(buffer.empty());
+    sendFromClient("GET / HTTP/1.1\r\n\r\nGET /next");
+    EXPECT_EQ(buffer.receiveFrom(sockets[0]), 27);
+    EXPECT_EQ(unconsumed(buffer), "GET / HTTP/1.1\r\n\r\nGET /next");
+
+    buffer.consume(18);
+    EXPECT_EQ(unconsumed(buffer), "GET /next"); // the pipelined request stays for the next round
+    sendFromClient(" HTTP/1.1");
+    receiveAll(buffer, sockets[0]);
+    EXPECT_EQ(unconsumed(buffer), "GET /next HTTP/1.1");
+    buffer.consume(1000);
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST_F(InputBufferTest, GivesTheBlockBackToThePoolWhenIdle)
+{
+    InputBufferPool &pool = InputBufferPool::getInstance();
+    InputBuffer first;
+    sendFromClient("request");
+    receiveAll(first, sockets[0]);
+    const char *block = first.peek();
+
+    first.release(); // something is still to be parsed, the block stays
+    EXPECT_EQ(first.peek(), block);
+    size_t pooled = pool.size();
+    first.consume(7);
+    first.release();
+    EXPECT_EQ(first.peek(), nullptr);
+    EXPECT_EQ(pool.size(), pooled + 1);
+
+    InputBuffer second; // the next connection reuses the block
+    sendFromClient("x");
+    receiveAll(second, sockets[0]);
+    EXPECT_EQ(second.peek(), block);
+    EXPECT_EQ(pool.size(), pooled);
+}
+
+TEST_F(InputBufferTest, MovesTheRestToTheStartWhenTheEndFillsUp)
+{
+    InputBuffer buffer;
+    std::string first(INPUT_BUFFER_BLOCK_SIZE - INPUT_BUFFER_MIN_READ, 'a'); // leaves just enough room for one more read
+    sendFromClient(first);
+    receiveAll(buffer, sockets[0]);
+    ASSERT_EQ(buffer.size(), first.size());
+    const char *block = buffer.peek();
+    buffer.consume(first.size() - 10);
+
+    sendFromClient(std::string(INPUT_BUFFER_MIN_READ, 'b'));
+    receiveAll(buffer, sockets[0]);
+    EXPECT_EQ(buffer.peek(), block); // moved within the same block, not grown
+    EXPECT_EQ(unconsumed(buffer), std::string(10, 'a') + std::string(INPUT_BUFFER_MIN_READ, 'b'));
+}
+
+TEST_F(InputBufferTest, GrowsForAHeadThatDoesNotFit)
+{
+    InputBufferPool &pool = InputBufferPool::getInstance();
+    InputBuffer buffer;
+    std::string head(INPUT_BUFFER_BLOCK_SIZE + 1000, 'h');
+    size_t sent = 0;
+    while (sent < head.size()) // the socket buffer may be smaller than the head
+    {
+        size_t piece = std::min(head.size() - sent, static_cast<size_t>(16384));
+        sendFromClient(head.substr(sent, piece));
+        sent += piece;
+        receiveAll(buffer, sockets[0]);
+    }
+    EXPECT_EQ(unconsumed(buffer), head); // still one contiguous run
+    size_t pooled = pool.size();
+
+    buffer.consume(head.size());
+    buffer.release(); // a grown block is freed, not pooled
+    EXPECT_EQ(pool.size(), pooled);
+}
+
+TEST(InputBufferPoolTest, KeepsAtMostThePoolSize)
+{
+    InputBufferPool &pool = InputBufferPool::getInstance();
+    while (pool.size() < INPUT_BUFFER_POOL_SIZE)
+        pool.giveBack(std::unique_ptr<char[]>(new char[INPUT_BUFFER_BLOCK_SIZE]));
+    pool.giveBack(std::unique_ptr<char[]>(new char[INPUT_BUFFER_BLOCK_SIZE]));
+    EXPECT_EQ(pool.size(), static_cast<size_t>(INPUT_BUFFER_POOL_SIZE));
+}
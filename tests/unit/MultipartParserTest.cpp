@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "../../src/Request/MultipartParser.hpp"
+
+static const std::string boundary = "XyZbound";
+
+static std::string formPart(std::string const &name, std::string const &data)
+{
+    return "--" + boundary + "\r\n"
+           "Content-Disposition: form-data; name=\"" + name + "\"; filename=\"" + name + ".bin\"\r\n"
+           "Content-Type: application/octet-stream\r\n"
+           "\r\n" + data + "\r\n";
+}
+
+static std::string closeDelimiter()
+{
+    return "--" + boundary + "--\r\n";
+}
+
+static void appendString(MultipartParser &parser, std::string const &input)
+{
+    parser.append(reinterpret_cast<const std::byte *>(input.data()), input.size());
+}
+
+// Feeds the input in reads of at most pieceSize bytes, like it comes off the socket
+static void appendInPieces(MultipartParser &parser, std::string const &input, size_t pieceSize)
+{
+    for (size_t offset = 0; offset < input.size(); offset += pieceSize)
+        appendString(parser, input.substr(offset, pieceSize));
+}
+
+static std::string partData(MultipartParser::Part const &part)
+{
+    return std::string(reinterpret_cast<const char *>(part.body.data()), part.body.getSize());
+}
+
+TEST(MultipartParserTest, ParsesParts)
+{
+    MultipartParser parser(boundary, DEFAULT_CLIENT_BODY_BUFFER_SIZE);
+    appendString(parser, formPart("first", "hello") + formPart("second", "") + closeDelimiter());
+
+    ASSERT_EQ(parser.getStatus(), MultipartParser::MULTIPART_COMPLETE);
+    ASSERT_EQ(parser.getParts().size(), 2u);
+    EXPECT_EQ(parser.getParts()[0].headers.at("content-disposition"), "form-data; name=\"first\"; filename=\"first.bin\"");
+    EXPECT_EQ(parser.getParts()[0].headers.at("content-type"), "application/octet-stream");
+    EXPECT_EQ(partData(parser.getParts()[0]), "hello");
+    EXPECT_EQ(partData(parser.getParts()[1]), "");
+}
+
+TEST(MultipartParserTest, IgnoresPreambleAndEpilogue)
+{
+    MultipartParser parser(boundary, DEFAULT_CLIENT_BODY_BUFFER_SIZE);
+    appendString(parser, "preamble\r\n" + formPart("a", "data") + closeDelimiter() + "epilogue --" + boundary + "\r\n");
+
+    ASSERT_EQ(parser.getStatus(), MultipartParser::MULTIPART_COMPLETE);
+    ASSERT_EQ(parser.getParts().size(), 1u);
+    EXPECT_EQ(partData(parser.getParts()[0]), "data");
+}
+
+TEST(MultipartParserTest, ParsesPartWithoutHeaders)
+{
+    MultipartParser parser(boundary, DEFAULT_CLIENT_BODY_BUFFER_SIZE);
+    appendString(parser, "--" + boundary + "  \r\n\r\nplain\r\n" + closeDelimiter());
+
+    ASSERT_EQ(parser.getStatus(), MultipartParser::MULTIPART_COMPLETE);
+    ASSERT_EQ(parser.getParts().size(), 1u);
+    EXPECT_TRUE(parser.getParts()[0].headers.empty());
+    EXPECT_EQ(partData(parser.getParts()[0]), "plain");
+}
+
+TEST(MultipartParserTest, ParsesBoundarySplitAcrossBuffers)
+{
+    // data that looks like the start of a delimiter, and a delimiter cut at every position
+    std::string data = "a\r\n--XyZbounc\r\n--XyZboun\r\r\n-\r\n--XyZbo";
+    std::string body = formPart("first", data) + formPart("second", "x") + closeDelimiter();
+
+    for (size_t pieceSize = 1; pieceSize <= body.size(); ++pieceSize)
+    {
+        MultipartParser parser(boundary, DEFAULT_CLIENT_BODY_BUFFER_SIZE);
+        appendInPieces(parser, body, pieceSize);
+        ASSERT_EQ(parser.getStatus(), MultipartParser::MULTIPART_COMPLETE) << pieceSize;
+        ASSERT_EQ(parser.getParts().size(), 2u) << pieceSize;
+        EXPECT_EQ(partData(parser.getParts()[0]), data) << pieceSize;
+        EXPECT_EQ(partData(parser.getParts()[1]), "x") << pieceSize;
+        EXPECT_EQ(parser.getReceivedSize(), body.size()) << pieceSize;
+    }
+}
+
+TEST(MultipartParserTest, ReportsMissingCloseDelimiter)
+{
+    MultipartParser parser(boundary, DEFAULT_CLIENT_BODY_BUFFER_SIZE);
+    appendString(parser, formPart("a", "data") + "--" + boundary + "-");
+
+    EXPECT_EQ(parser.getStatus(), MultipartParser::MULTIPART_INCOMPLETE);
+}
+
+TEST(MultipartParserTest, ReportsMissingFirstDelimiter)
+{
+    MultipartParser parser(boundary, DEFAULT_CLIENT_BODY_BUFFER_SIZE);
+    appendString(parser, "no delimiter at all\r\n");
+
+    EXPECT_EQ(parser.getStatus(), MultipartParser::MULTIPART_INCOMPLETE);
+    EXPECT_TRUE(parser.getParts().empty());
+}
+
+TEST(MultipartParserTest, RejectsBadDelimiterLine)
+{
+    MultipartParser parser(boundary, DEFAULT_CLIENT_BODY_BUFFER_SIZE);
+    appendString(parser, "--" + boundary + "junk\r\n\r\ndata\r\n" + closeDelimiter());
+
+    EXPECT_EQ(parser.getStatus(), MultipartParser::MULTIPART_BAD_SYNTAX);
+}
+
+TEST(MultipartParserTest, RejectsOversizedPartHeaders)
+{
+    MultipartParser parser(boundary, DEFAULT_CLIENT_BODY_BUFFER_SIZE);
+    appendString(parser, "--" + boundary + "\r\nX-Long: " + std::string(MULTIPART_MAX_HEADER_SIZE, 'a') + "\r\n\r\ndata\r\n" + closeDelimiter());
+
+    EXPECT_EQ(parser.getStatus(), MultipartParser::MULTIPART_BAD_SYNTAX);
+}
+
+TEST(MultipartParserTest, SpoolsPartsOverTheBufferSize)
+{
+    std::string large(300, 'L');
+    MultipartParser parser(boundary, 256);
+    appendString(parser, formPart("small", "s") + formPart("large", large) + closeDelimiter());
+
+    ASSERT_EQ(parser.getStatus(), MultipartParser::MULTIPART_COMPLETE);
+    ASSERT_EQ(parser.getParts().size(), 2u);
+    EXPECT_FALSE(parser.getParts()[0].body.isSpooled());
+    EXPECT_TRUE(parser.getParts()[1].body.isSpooled());
+    EXPECT_EQ(partData(parser.getParts()[1]), large);
+}
+
+TEST(MultipartParserTest, RejectsTooManyParts)
+{
+    std::string body;
+    for (int i = 0; i <= MULTIPART_MAX_PARTS; ++i)
+        body += formPart("f" + std::to_string(i), "x");
+    MultipartParser parser(boundary, DEFAULT_CLIENT_BODY_BUFFER_SIZE);
+    appendString(parser, body + closeDelimiter());
+
+    EXPECT_EQ(parser.getStatus(), MultipartParser::MULTIPART_TOO_LARGE);
+    EXPECT_EQ(parser.getParts().size(), static_cast<size_t>(MULTIPART_MAX_PARTS));
+}
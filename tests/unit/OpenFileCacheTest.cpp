@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <string>
+#include <cstdio>
+#include "../../src/Utils/OpenFileCache.hpp"
+
+// The cache of the test thread, with files written next to the test configs
+class OpenFileCacheTest : public ::testing::Test
+{
+protected:
+    std::string path = "configs/test_files/test_OpenFileCache.txt";
+    std::string otherPath = "configs/test_files/test_OpenFileCache2.txt";
+
+    void SetUp() override
+    {
+        OpenFileCache::getInstance().configure(10, 60000, false);
+        writeFile(path, "first");
+    }
+
+    void TearDown() override
+    {
+        OpenFileCache::getInstance().configure(0, 0, false);
+        std::remove(path.c_str());
+        std::remove(otherPath.c_str());
+    }
+
+    static void writeFile(std::string const &filePath, std::string const &content)
+    {
+        std::ofstream file(filePath, std::ios::trunc);
+        file << content;
+    }
+};
+
+TEST_F(OpenFileCacheTest, LookupDoesNotOpenTheFile)
+{
+    OpenFileCache::FileInfo info = OpenFileCache::getInstance().lookup(path);
+    EXPECT_EQ(info.error, 0);
+    EXPECT_TRUE(info.isFile);
+    EXPECT_EQ(info.size, 5);
+    EXPECT_EQ(info.file, nullptr);
+    EXPECT_EQ(OpenFileCache::getInstance().lookup(path).file, nullptr); // a hit does not open it either
+}
+
+TEST_F(OpenFileCacheTest, KeepsTheFileOpenedForTheEntry)
+{
+    OpenFileCache &cache = OpenFileCache::getInstance();
+    std::shared_ptr<OpenFile> file = cache.open(cache.lookup(path), path);
+    ASSERT_NE(file, nullptr);
+    EXPECT_EQ(file->getSize(), 5);
+    EXPECT_EQ(cache.lookup(path).file, file);
+    EXPECT_EQ(cache.open(cache.lookup(path), path), file);
+}
+
+TEST_F(OpenFileCacheTest, DoesNotKeepAFileReplacedSinceTheLookup)
+{
+    OpenFileCache &cache = OpenFileCache::getInstance();
+    OpenFileCache::FileInfo info = cache.lookup(path);
+    writeFile(otherPath, "replaced");
+    ASSERT_EQ(std::rename(otherPath.c_str(), path.c_str()), 0);
+
+    std::shared_ptr<OpenFile> file = cache.open(info, path);
+    EXPECT_EQ(file->getSize(), 8); // what is sent is what was opened
+    EXPECT_EQ(cache.lookup(path).file, nullptr);
+}
+
+TEST_F(OpenFileCacheTest, OpenThrowsForAMissingFile)
+{
+    OpenFileCache &cache = OpenFileCache::getInstance();
+    OpenFileCache::FileInfo info = cache.lookup(otherPath);
+    EXPECT_EQ(info.error, ENOENT);
+    EXPECT_THROW(cache.open(info, otherPath), std::runtime_error);
+}
+
+TEST_F(OpenFileCacheTest, DropsTheLeastRecentlyUsedEntry)
+{
+    OpenFileCache &cache = OpenFileCache::getInstance();
+    cache.configure(2, 60000, false);
+    writeFile(otherPath, "second");
+    std::shared_ptr<OpenFile> first = cache.open(cache.lookup(path), path);
+    std::shared_ptr<OpenFile> second = cache.open(cache.lookup(otherPath), otherPath);
+    cache.lookup(path); // the first one is now the most recently used
+    cache.lookup("configs/test_files"); // a third path pushes out the second
+    EXPECT_EQ(cache.size(), 2U);
+
+    EXPECT_EQ(cache.lookup(path).file, first);
+    EXPECT_EQ(cache.lookup(otherPath).file, nullptr);
+}
+
+TEST_F(OpenFileCacheTest, InvalidateDropsTheEntry)
+{
+    OpenFileCache &cache = OpenFileCache::getInstance();
+    std::shared_ptr<OpenFile> file = cache.open(cache.lookup("/" + path + "/"), path);
+    writeFile(path, "changed by an upload");
+    EXPECT_EQ(cache.lookup(path).size, 5); // still valid, the file system is not asked
+
+    cache.invalidate("/" + path);
+    OpenFileCache::FileInfo info = cache.lookup(path);
+    EXPECT_EQ(info.size, 20);
+    EXPECT_EQ(info.file, nullptr);
+}
+
+TEST_F(OpenFileCacheTest, RevalidatesExpiredEntries)
+{
+    OpenFileCache &cache = OpenFileCache::getInstance();
+    cache.configure(10, 0, false); // every entry expires at once
+    std::shared_ptr<OpenFile> file = cache.open(cache.lookup(path), path);
+    EXPECT_EQ(cache.lookup(path).file, file); // unchanged, the open file is kept
+
+    writeFile(path, "longer content");
+    OpenFileCache::FileInfo info = cache.lookup(path);
+    EXPECT_EQ(info.size, 14);
+    EXPECT_EQ(info.file, nullptr);
+}
+
+TEST_F(OpenFileCacheTest, CachesErrorsOnlyWhenAskedTo)
+{
+    OpenFileCache &cache = OpenFileCache::getInstance();
+    EXPECT_EQ(cache.lookup(otherPath).error, ENOENT);
+    EXPECT_EQ(cache.size(), 0U);
+
+    cache.configure(10, 60000, true);
+    EXPECT_EQ(cache.lookup(otherPath).error, ENOENT);
+    writeFile(otherPath, "now it exists");
+    EXPECT_EQ(cache.lookup(otherPath).error, ENOENT); // until the entry expires
+    cache.invalidate(otherPath);
+    EXPECT_EQ(cache.lookup(otherPath).error, 0);
+}
+
+TEST_F(OpenFileCacheTest, GoesToTheFileSystemWhenOff)
+{
+    OpenFileCache &cache = OpenFileCache::getInstance();
+    cache.configure(0, 60000, true);
+    EXPECT_TRUE(cache.lookup(path).isFile);
+    EXPECT_TRUE(cache.lookup("configs/test_files").isDir);
+    EXPECT_EQ(cache.size(), 0U);
+    writeFile(path, "0123456789");
+    EXPECT_EQ(cache.lookup(path).size, 10);
+}
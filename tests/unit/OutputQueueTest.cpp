@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <string>
+#include <cstdio>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include "../../src/Server/OutputQueue.hpp"
+
+// A connected socket pair with a small, non-blocking sending end, so that a large queue
+// only goes out in several partial writes like it does to a slow client
+class OutputQueueTest : public ::testing::Test
+{
+protected:
+    int sockets[2] = {-1, -1};
+    std::string path = "configs/test_files/test_OutputQueue.bin";
+
+    void SetUp() override
+    {
+        ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0);
+        int bufferSize = 4096;
+        setsockopt(sockets[0], SOL_SOCKET, SO_SNDBUF, &bufferSize, sizeof(bufferSize));
+        setsockopt(sockets[1], SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof(bufferSize));
+        fcntl(sockets[0], F_SETFL, O_NONBLOCK);
+        fcntl(sockets[1], F_SETFL, O_NONBLOCK);
+    }
+
+    void TearDown() override
+    {
+        close(sockets[0]);
+        close(sockets[1]);
+        std::remove(path.c_str());
+    }
+
+    std::shared_ptr<OpenFile> writeFile(std::string const &content)
+    {
+        std::ofstream file(path, std::ios::trunc | std::ios::binary);
+        file << content;
+        file.close();
+        return std::make_shared<OpenFile>(path);
+    }
+
+    // whatever the peer has received so far
+    std::string drain()
+    {
+        std::string received;
+        char buffer[65536];
+        ssize_t bytes;
+        while ((bytes = recv(sockets[1], buffer, sizeof(buffer), 0)) > 0)
+            received.append(buffer, bytes);
+        return received;
+    }
+
+    // send until the queue is empty, reading on the other end whenever the socket is full
+    std::string sendAll(OutputQueue &queue, size_t &partialSends)
+    {
+        std::string received;
+        partialSends = 0;
+        while (!queue.empty())
+        {
+            size_t queuedBefore = queue.size();
+            ssize_t bytes = queue.sendTo(sockets[0]);
+            if (bytes < 0)
+                EXPECT_TRUE(errno == EAGAIN || errno == EWOULDBLOCK) << strerror(errno);
+            else
+                EXPECT_EQ(queue.size(), queuedBefore - bytes);
+            if (!queue.empty())
+                ++partialSends;
+            received += drain();
+        }
+        return received + drain();
+    }
+};
+
+static std::string pattern(size_t size, char seed)
+{
+    std::string text(size, '\0');
+    for (size_t i = 0; i < size; ++i)
+        text[i] = static_cast<char>(seed + i % 251);
+    return text;
+}
+
+static std::vector<std::byte> toBytes(std::string const &text)
+{
+    const std::byte *data = reinterpret_cast<const std::byte *>(text.data());
+    return std::vector<std::byte>(data, data + text.size());
+}
+
+TEST_F(OutputQueueTest, SendsMemorySegmentsInOrder)
+{
+    std::string header = "HTTP/1.1 200 OK\r\n\r\n";
+    std::string owned = pattern(5000, 'a');
+    std::string shared = pattern(3000, 'b');
+    auto sharedBuffer = std::make_shared<const std::vector<std::byte>>(toBytes(shared));
+
+    OutputQueue queue;
+    queue.append(header);
+    queue.append(toBytes(owned));
+    queue.append(sharedBuffer, 100, 2000); // one range of a cached body
+    queue.append(sharedBuffer);
+    queue.append(std::string(""));
+    EXPECT_EQ(queue.size(), header.size() + owned.size() + 2000 + shared.size());
+
+    size_t partialSends = 0;
+    std::string received = sendAll(queue, partialSends);
+    EXPECT_EQ(received, header + owned + shared.substr(100, 2000) + shared);
+    EXPECT_GT(partialSends, 0U); // the small socket buffer made it resume mid-segment
+    EXPECT_EQ(sharedBuffer.use_count(), 1); // the queue let go of the shared buffer
+}
+
+TEST_F(OutputQueueTest, ResumesAMemorySegmentWhereTheSocketFilledUp)
+{
+    std::string body = pattern(300000, 'm');
+    OutputQueue queue;
+    queue.append(toBytes(body));
+
+    ssize_t first = queue.sendTo(sockets[0]);
+    ASSERT_GT(first, 0);
+    ASSERT_LT(static_cast<size_t>(first), body.size());
+    EXPECT_EQ(queue.sendTo(sockets[0]), -1); // nothing more fits until the peer reads
+    EXPECT_TRUE(errno == EAGAIN || errno == EWOULDBLOCK);
+    EXPECT_EQ(queue.size(), body.size() - first);
+
+    size_t partialSends = 0;
+    std::string received = drain();
+    received += sendAll(queue, partialSends);
+    EXPECT_EQ(received, body);
+}
+
+TEST_F(OutputQueueTest, ClearDropsWhatIsLeft)
+{
+    OutputQueue queue;
+    queue.append(std::string("abc"));
+    queue.append(toBytes(pattern(10, 'x')));
+    queue.clear();
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.size(), 0U);
+    EXPECT_EQ(queue.sendTo(sockets[0]), 0);
+    EXPECT_EQ(drain(), "");
+}
+
+TEST_F(OutputQueueTest, SendsFileSegmentsBetweenMemorySegments)
+{
+    std::string header = "HTTP/1.1 206 Partial Content\r\n\r\n";
+    std::string fileContent = pattern(200000, 'c');
+    std::shared_ptr<OpenFile> file = writeFile(fileContent);
+
+    OutputQueue queue;
+    queue.append(header);
+    queue.appendFile(file, 10, 70000, true);
+    queue.append(std::string("\r\n--boundary\r\n"));
+    queue.appendFile(file, 100000, 90000, true);
+    queue.appendFile(file, 0, 0, true); // an empty range adds nothing
+    EXPECT_EQ(queue.size(), header.size() + 70000 + 14 + 90000);
+
+    size_t partialSends = 0;
+    std::string received = sendAll(queue, partialSends);
+    EXPECT_EQ(received, header + fileContent.substr(10, 70000) + "\r\n--boundary\r\n" + fileContent.substr(100000, 90000));
+    EXPECT_GT(partialSends, 0U);
+}
+
+TEST_F(OutputQueueTest, StreamsAFileWindowByWindow)
+{
+    std::string fileContent = pattern(50000, 'w');
+    OutputQueue queue;
+    queue.setWindowSize(777); // not a divisor of anything, every window ends mid-write
+    queue.appendFile(writeFile(fileContent), 0, fileContent.size(), false);
+
+    size_t partialSends = 0;
+    EXPECT_EQ(sendAll(queue, partialSends), fileContent);
+}
+
+TEST_F(OutputQueueTest, StreamsOnlyTheFileSegmentsWithoutZeroCopy)
+{
+    std::string fileContent = pattern(20000, 's');
+    std::shared_ptr<OpenFile> file = writeFile(fileContent);
+    OutputQueue queue;
+    queue.setWindowSize(1000);
+    queue.appendFile(file, 0, 5000, false);
+    queue.append(std::string("|"));
+    queue.appendFile(file, 5000, 15000, true);
+    queue.appendFile(file, 123, 4567, false);
+
+    size_t partialSends = 0;
+    EXPECT_EQ(sendAll(queue, partialSends), fileContent.substr(0, 5000) + "|" + fileContent.substr(5000) + fileContent.substr(123, 4567));
+}
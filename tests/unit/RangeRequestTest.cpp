@@ -0,0 +1,109 @@
+#include "StaticFileTest.hpp"
+
+static std::vector<Request::ByteRange> parsedRanges(Request const &request)
+{
+    return request.getRanges();
+}
+
+static bool operator==(Request::ByteRange const &a, Request::ByteRange const &b)
+{
+    return a.first == b.first && a.last == b.last;
+}
+
+class RangeRequestTest : public StaticFileTest
+{
+};
+
+TEST_F(RangeRequestTest, ParsesByteRangeSpecs)
+{
+    Request req = request("Range: bytes=0-9, 20- ,-5,7-7");
+    std::vector<Request::ByteRange> expected = {{0, 9}, {20, -1}, {-1, 5}, {7, 7}};
+    ASSERT_EQ(req.getRanges().size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+        EXPECT_TRUE(req.getRanges()[i] == expected[i]) << i;
+    EXPECT_EQ(request("Range: BYTES=1-2").getRanges().size(), 1U); // the unit is case-insensitive
+}
+
+TEST_F(RangeRequestTest, IgnoresInvalidRangeHeaders)
+{
+    EXPECT_TRUE(parsedRanges(request("Range: bytes=5-2")).empty());
+    EXPECT_TRUE(parsedRanges(request("Range: bytes=-")).empty());
+    EXPECT_TRUE(parsedRanges(request("Range: bytes=1-2,x-3")).empty()); // one bad spec spoils the header
+    EXPECT_TRUE(parsedRanges(request("Range: items=0-1")).empty());
+    EXPECT_TRUE(parsedRanges(request("Range: bytes=")).empty());
+    EXPECT_TRUE(parsedRanges(request("Range: bytes=0-" + std::string(RANGE_MAX_DIGITS + 1, '9'))).empty());
+    EXPECT_EQ(request("If-Range: \"abc\"").getIfRange(), ""); // only kept with a Range
+}
+
+TEST_F(RangeRequestTest, SendsOneRangeAsPartialContent)
+{
+    Request req = request("Range: bytes=10-19");
+    Response response(req);
+    EXPECT_EQ(response.getStatusCode(), HttpStatusCode::PARTIAL_CONTENT);
+    EXPECT_EQ(header(response, "Content-Range"), "bytes 10-19/1000");
+    std::vector<Response::BodyRange> ranges = response.takeBodyRanges();
+    ASSERT_EQ(ranges.size(), 1U);
+    EXPECT_EQ(ranges[0].offset, 10);
+    EXPECT_EQ(ranges[0].length, 10U);
+    EXPECT_EQ(ranges[0].head, "");
+}
+
+TEST_F(RangeRequestTest, ResolvesOpenAndSuffixRangesAgainstTheFileSize)
+{
+    Request suffix = request("Range: bytes=-5");
+    EXPECT_EQ(header(Response(suffix), "Content-Range"), "bytes 995-999/1000");
+    Request open = request("Range: bytes=990-");
+    EXPECT_EQ(header(Response(open), "Content-Range"), "bytes 990-999/1000");
+    Request pastTheEnd = request("Range: bytes=900-5000");
+    EXPECT_EQ(header(Response(pastTheEnd), "Content-Range"), "bytes 900-999/1000");
+    Request longSuffix = request("Range: bytes=-5000");
+    EXPECT_EQ(header(Response(longSuffix), "Content-Range"), "bytes 0-999/1000");
+}
+
+TEST_F(RangeRequestTest, SendsSeveralRangesAsMultipart)
+{
+    Request req = request("Range: bytes=0-1,5000-6000,-2");
+    Response response(req);
+    EXPECT_EQ(response.getStatusCode(), HttpStatusCode::PARTIAL_CONTENT);
+    std::string contentType = header(response, "Content-Type");
+    ASSERT_EQ(contentType.compare(0, 31, "multipart/byteranges; boundary="), 0) << contentType;
+    std::string boundary = contentType.substr(31);
+
+    std::vector<Response::BodyRange> ranges = response.takeBodyRanges();
+    ASSERT_EQ(ranges.size(), 2U); // the one past the end is dropped
+    EXPECT_NE(ranges[0].head.find("--" + boundary + "\r\n"), std::string::npos);
+    EXPECT_NE(ranges[0].head.find("Content-Range: bytes 0-1/1000\r\n\r\n"), std::string::npos);
+    EXPECT_NE(ranges[1].head.find("Content-Range: bytes 998-999/1000\r\n\r\n"), std::string::npos);
+    EXPECT_EQ(response.getBodyRangesTail(), "\r\n--" + boundary + "--\r\n");
+}
+
+TEST_F(RangeRequestTest, RefusesRangesThatAreAllPastTheEnd)
+{
+    Request req = request("Range: bytes=1000-,2000-3000");
+    Response response(req);
+    EXPECT_EQ(response.getStatusCode(), HttpStatusCode::RANGE_NOT_SATISFIABLE);
+    EXPECT_EQ(header(response, "Content-Range"), "bytes */1000");
+}
+
+TEST_F(RangeRequestTest, SendsTheWholeFileWhenIfRangeIsStale)
+{
+    Request plain = request();
+    std::string lastModified = header(Response(plain), "Last-Modified");
+    ASSERT_FALSE(lastModified.empty());
+
+    Request current = request("Range: bytes=0-0\r\nIf-Range: " + lastModified);
+    EXPECT_EQ(Response(current).getStatusCode(), HttpStatusCode::PARTIAL_CONTENT);
+    Request stale = request("Range: bytes=0-0\r\nIf-Range: Thu, 01 Jan 1970 00:00:00 GMT");
+    Response response(stale);
+    EXPECT_EQ(response.getStatusCode(), HttpStatusCode::OK);
+    EXPECT_TRUE(response.takeBodyRanges().empty());
+}
+
+TEST_F(RangeRequestTest, AppliesToGetOnly)
+{
+    Request req = request("Range: bytes=0-9", "HEAD");
+    Response response(req);
+    EXPECT_EQ(response.getStatusCode(), HttpStatusCode::OK);
+    EXPECT_EQ(header(response, "Content-Range"), "");
+    EXPECT_EQ(response.getContentLength(), 1000U);
+}
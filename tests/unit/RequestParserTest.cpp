@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+#include "../../src/Request/RequestParser.hpp"
+
+// The head as the server hands it over: everything before the empty line, without its CRLF CRLF
+static HttpStatusCode parseFailureStatus(std::string_view head)
+{
+    try
+    {
+        RequestParser parser(head);
+    }
+    catch (const RequestParser::ParseException &e)
+    {
+        return e.getStatusCode();
+    }
+    return HttpStatusCode::UNDEFINED_STATUS;
+}
+
+TEST(RequestParserTest, ParsesRequestLineAndHeaders)
+{
+    RequestParser parser("GET /index.html?a=b HTTP/1.1\r\n"
+                         "Host: localhost:10001\r\n"
+                         "Accept-Encoding:gzip, br  \r\n"
+                         "X-Empty:");
+    EXPECT_EQ(parser.getRequestLine().method, "GET");
+    EXPECT_EQ(parser.getRequestLine().target, "/index.html?a=b");
+    EXPECT_EQ(parser.getRequestLine().versionMajor, "1");
+    EXPECT_EQ(parser.getRequestLine().versionMinor, "1");
+    ASSERT_NE(parser.findHeader("host"), nullptr);
+    EXPECT_EQ(*parser.findHeader("HOST"), "localhost:10001");
+    ASSERT_NE(parser.findHeader("Accept-Encoding"), nullptr);
+    EXPECT_EQ(*parser.findHeader("Accept-Encoding"), "gzip, br");
+    ASSERT_NE(parser.findHeader("X-Empty"), nullptr);
+    EXPECT_EQ(*parser.findHeader("X-Empty"), "");
+    EXPECT_EQ(parser.findHeader("Content-Length"), nullptr);
+}
+
+TEST(RequestParserTest, RejectsMalformedRequestLine)
+{
+    EXPECT_EQ(parseFailureStatus(""), HttpStatusCode::BAD_REQUEST);
+    EXPECT_EQ(parseFailureStatus("GET / HTTP/1.1"), HttpStatusCode::BAD_REQUEST);
+    EXPECT_EQ(parseFailureStatus("GET  / HTTP/1.1\r\nHost: a"), HttpStatusCode::BAD_REQUEST);
+    EXPECT_EQ(parseFailureStatus("GET / HTTP/1.1 \r\nHost: a"), HttpStatusCode::BAD_REQUEST);
+    EXPECT_EQ(parseFailureStatus("GET / HTTPS/1.1\r\nHost: a"), HttpStatusCode::BAD_REQUEST);
+    EXPECT_EQ(parseFailureStatus("GET / HTTP/1\r\nHost: a"), HttpStatusCode::BAD_REQUEST);
+    EXPECT_EQ(parseFailureStatus("GET / HTTP/1234.1\r\nHost: a"), HttpStatusCode::BAD_REQUEST);
+    EXPECT_EQ(parseFailureStatus("GET /a b HTTP/1.1\r\nHost: a"), HttpStatusCode::BAD_REQUEST);
+}
+
+TEST(RequestParserTest, RejectsObsoleteLineFolding)
+{
+    EXPECT_EQ(parseFailureStatus("GET / HTTP/1.1\r\n"
+                                 "Host: localhost\r\n"
+                                 "X-Folded: first\r\n"
+                                 " second"),
+              HttpStatusCode::BAD_REQUEST);
+    EXPECT_EQ(parseFailureStatus("GET / HTTP/1.1\r\n"
+                                 "Host: localhost\r\n"
+                                 "X-Folded: first\r\n"
+                                 "\tsecond"),
+              HttpStatusCode::BAD_REQUEST);
+}
+
+TEST(RequestParserTest, RejectsDuplicateHeader)
+{
+    EXPECT_EQ(parseFailureStatus("GET / HTTP/1.1\r\n"
+                                 "Host: a\r\n"
+                                 "host: b"),
+              HttpStatusCode::BAD_REQUEST);
+    EXPECT_EQ(parseFailureStatus("POST / HTTP/1.1\r\n"
+                                 "Host: a\r\n"
+                                 "Content-Length: 5\r\n"
+                                 "Content-Length: 5"),
+              HttpStatusCode::BAD_REQUEST);
+}
+
+TEST(RequestParserTest, RejectsMalformedHeaderLine)
+{
+    EXPECT_EQ(parseFailureStatus("GET / HTTP/1.1\r\nHost : a"), HttpStatusCode::BAD_REQUEST);
+    EXPECT_EQ(parseFailureStatus("GET / HTTP/1.1\r\nHost a"), HttpStatusCode::BAD_REQUEST);
+    EXPECT_EQ(parseFailureStatus("GET / HTTP/1.1\r\n: a"), HttpStatusCode::BAD_REQUEST);
+    EXPECT_EQ(parseFailureStatus("GET / HTTP/1.1\r\nHost: a\r\n\r\nX: b"), HttpStatusCode::BAD_REQUEST);
+    EXPECT_EQ(parseFailureStatus(std::string_view("GET / HTTP/1.1\r\nHost: a\0b", 25)), HttpStatusCode::BAD_REQUEST);
+    EXPECT_EQ(parseFailureStatus("GET / HTTP/1.1\r\nHost: a\rb"), HttpStatusCode::BAD_REQUEST);
+}
+
+TEST(RequestParserTest, RejectsTooManyHeaders)
+{
+    std::string head = "GET / HTTP/1.1";
+    for (int i = 0; i <= MAX_HEADER_FIELDS; ++i)
+        head += "\r\nX-Field-" + std::to_string(i) + ": " + std::to_string(i);
+    EXPECT_EQ(parseFailureStatus(head), HttpStatusCode::REQUEST_HEADER_FIELDS_TOO_LARGE);
+}
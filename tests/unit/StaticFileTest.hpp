@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <cstdio>
+#include "ConfigParserTest.hpp"
+#include "../../src/Request/Request.hpp"
+#include "../../src/Response/Response.hpp"
+
+// A server with one location serving configs/test_files, and one file in it to request
+class StaticFileTest : public ::testing::Test
+{
+protected:
+    std::string filePath = "configs/test_files/test_static.txt";
+    std::string content;
+    std::unique_ptr<ConfigParser> parser;
+
+    void SetUp() override
+    {
+        for (size_t i = 0; content.size() < 1000; ++i)
+            content += static_cast<char>('a' + i % 26);
+        std::ofstream file(filePath, std::ios::trunc | std::ios::binary);
+        file << content;
+        file.close();
+
+        TestConfigFile config("configs/test_files/test_StaticFile.conf",
+                              "server {\n"
+                              "    listen 10001;\n"
+                              "    location / {\n"
+                              "        alias /configs/test_files;\n"
+                              "        allowed_method GET HEAD;\n"
+                              "    }\n"
+                              "}\n");
+        std::string configPath = config.path();
+        parser = std::make_unique<ConfigParser>(configPath);
+        parser->extractServerConfigs();
+    }
+
+    void TearDown() override
+    {
+        std::remove(filePath.c_str());
+    }
+
+    // the head of a GET for the file, with the given header lines after Host
+    std::string head(std::string const &headers = "", std::string const &method = "GET") const
+    {
+        return method + " /test_static.txt HTTP/1.1\r\nHost: localhost:10001" + (headers.empty() ? "" : "\r\n" + headers);
+    }
+
+    Request request(std::string const &headers = "", std::string const &method = "GET") const
+    {
+        return Request(parser->getServerConfigs(), head(headers, method));
+    }
+
+    // the value of a header in the formatted response head, empty if it is not there
+    static std::string header(Response const &response, std::string const &name)
+    {
+        std::string responseHead = response.formatResponseHead();
+        size_t start = responseHead.find("\r\n" + name + ": ");
+        if (start == std::string::npos)
+            return "";
+        start += name.size() + 4;
+        return responseHead.substr(start, responseHead.find("\r\n", start) - start);
+    }
+};
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <chrono>
+#include "../../src/Server/TimerWheel.hpp"
+
+// Times are taken half a tick away from the expiry, so the few microseconds between the wheel's
+// start and the test's own start never move a timer to another tick
+class TimerWheelTest : public ::testing::Test
+{
+protected:
+    TimerWheel wheel;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    std::vector<int> advanceTo(size_t const &ms)
+    {
+        std::vector<int> expired;
+        wheel.advance(start + std::chrono::milliseconds(ms), expired);
+        return expired;
+    }
+};
+
+TEST_F(TimerWheelTest, ExpiresAtItsTick)
+{
+    TimerWheel::TimerHandle handle;
+    wheel.schedule(handle, 7, 1000);
+    EXPECT_TRUE(handle.active);
+    EXPECT_EQ(wheel.size(), 1U);
+
+    EXPECT_TRUE(advanceTo(1000 - TIMER_WHEEL_TICK_MS / 2).empty());
+    EXPECT_EQ(advanceTo(1000 + TIMER_WHEEL_TICK_MS / 2), std::vector<int>({7}));
+    EXPECT_FALSE(handle.active);
+    EXPECT_EQ(wheel.size(), 0U);
+}
+
+TEST_F(TimerWheelTest, RoundsShortTimeoutsUpToOneTick)
+{
+    TimerWheel::TimerHandle handle;
+    wheel.schedule(handle, 3, 0);
+    EXPECT_EQ(advanceTo(TIMER_WHEEL_TICK_MS + TIMER_WHEEL_TICK_MS / 2), std::vector<int>({3}));
+}
+
+TEST_F(TimerWheelTest, CascadesFromUpperLevels)
+{
+    // one timer in each level: within the root turn, within one level 1 turn, and beyond it
+    size_t rootTurnMs = (static_cast<size_t>(1) << TIMER_WHEEL_ROOT_BITS) * TIMER_WHEEL_TICK_MS;
+    size_t levelOneTurnMs = rootTurnMs << TIMER_WHEEL_LEVEL_BITS;
+    size_t timeoutsMs[] = {rootTurnMs / 2, rootTurnMs + 3 * TIMER_WHEEL_TICK_MS, levelOneTurnMs + 5 * TIMER_WHEEL_TICK_MS};
+    TimerWheel::TimerHandle handles[3];
+    for (int fd = 0; fd < 3; ++fd)
+        wheel.schedule(handles[fd], fd, timeoutsMs[fd]);
+
+    for (int fd = 0; fd < 3; ++fd)
+    {
+        EXPECT_TRUE(advanceTo(timeoutsMs[fd] - TIMER_WHEEL_TICK_MS / 2).empty()) << fd;
+        EXPECT_EQ(advanceTo(timeoutsMs[fd] + TIMER_WHEEL_TICK_MS / 2), std::vector<int>({fd})) << fd;
+    }
+    EXPECT_EQ(wheel.size(), 0U);
+}
+
+TEST_F(TimerWheelTest, ExpiresEverythingDueInOneAdvance)
+{
+    TimerWheel::TimerHandle handles[4];
+    wheel.schedule(handles[0], 10, 300);
+    wheel.schedule(handles[1], 11, 100);
+    wheel.schedule(handles[2], 12, 30000);
+    wheel.schedule(handles[3], 13, 200);
+
+    EXPECT_EQ(advanceTo(350), std::vector<int>({11, 13, 10})); // in expiry order
+    EXPECT_EQ(wheel.size(), 1U);
+    EXPECT_TRUE(handles[2].active);
+}
+
+TEST_F(TimerWheelTest, CancelledAndRescheduledTimersDoNotFire)
+{
+    TimerWheel::TimerHandle cancelled;
+    TimerWheel::TimerHandle moved;
+    wheel.schedule(cancelled, 1, 500);
+    wheel.schedule(moved, 2, 500);
+    wheel.cancel(cancelled);
+    wheel.schedule(moved, 2, 2000);
+    EXPECT_FALSE(cancelled.active);
+    EXPECT_EQ(wheel.size(), 1U);
+
+    EXPECT_TRUE(advanceTo(1050).empty());
+    EXPECT_EQ(advanceTo(2050), std::vector<int>({2}));
+    wheel.cancel(moved); // already expired, nothing to do
+    EXPECT_EQ(wheel.size(), 0U);
+}
+
+TEST_F(TimerWheelTest, ReportsHowLongTheLoopMaySleep)
+{
+    EXPECT_EQ(wheel.getNextTimeoutMs(), -1);
+    TimerWheel::TimerHandle handle;
+    wheel.schedule(handle, 1, 500);
+    int timeoutMs = wheel.getNextTimeoutMs();
+    EXPECT_GT(timeoutMs, 0);
+    EXPECT_LE(timeoutMs, 500);
+}